@@ -6,7 +6,9 @@
 #include <algorithm>
 #include<bits/stdc++.h>
 
-// Constants for thresholds
+// Constants for thresholds. This exercise is a standalone file outside the fleet-management
+// build, so it keeps its own copy of AlertThresholds (fleet-management/src/AlertEngine.h);
+// keep the two in step.
 namespace Constants {
     constexpr double CRITICAL_TEMP = 110.0;
     constexpr double LOW_FUEL_THRESHOLD = 15.0;
@@ -134,6 +136,11 @@ public:
         vehicles.push_back(vehicle);
     }
 
+    // Add a vehicle the caller no longer needs, without copying it
+    void addVehicle(Vehicle&& vehicle) {
+        vehicles.push_back(std::move(vehicle));
+    }
+
     // Process and display alerts
     void checkAlerts() const {
         for (const auto& vehicle : vehicles) {
@@ -194,8 +201,7 @@ int main() {
                 double speed = std::get<1>(vehicleTuple);
                 double temp = std::get<2>(vehicleTuple);
                 double fuel = std::get<3>(vehicleTuple);
-                Vehicle vehicle(id, speed, temp, fuel);
-                fleet.addVehicle(vehicle);
+                fleet.addVehicle(Vehicle(id, speed, temp, fuel));
             }
             catch (const std::invalid_argument& e) {
                 std::cerr << "Error creating vehicle " << std::get<0>(vehicleTuple) << ": " << e.what() << "\n";
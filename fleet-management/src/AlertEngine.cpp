@@ -0,0 +1,459 @@
+#include "AlertEngine.h"
+#include "AlertRules.h"
+#include "SimdKernels.h"
+#include "Instrumentation.h"
+#include "TaskPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char ALERT_PREFIX[] = "Vehicle ID ";
+    constexpr char OVERHEATING_SUFFIX[] = ": Critical Overheating\n";
+    constexpr char LOW_FUEL_SUFFIX[] = ": Low Fuel Warning\n";
+    constexpr char OVERHEATING_CLEARED_SUFFIX[] = ": Overheating Cleared\n";
+    constexpr char LOW_FUEL_CLEARED_SUFFIX[] = ": Low Fuel Cleared\n";
+    // Longest possible line: prefix + "-2147483648" + longest suffix.
+    constexpr std::size_t MAX_LINE = sizeof(ALERT_PREFIX) - 1 + 11 + sizeof(OVERHEATING_SUFFIX) - 1;
+
+    std::size_t popcount(const std::vector<std::uint64_t>& words) {
+        std::size_t bits = 0;
+        for (std::uint64_t w : words) {
+            for (; w; w &= w - 1) ++bits;
+        }
+        return bits;
+    }
+
+    template<std::size_t N>
+    char* append(char* out, const char (&literal)[N]) {
+        std::memcpy(out, literal, N - 1);
+        return out + N - 1;
+    }
+
+    char* appendLine(char* out, int id, const char* suffix, std::size_t suffixLength) {
+        out = append(out, ALERT_PREFIX);
+        out = std::to_chars(out, out + 11, id).ptr;
+        std::memcpy(out, suffix, suffixLength);
+        return out + suffixLength;
+    }
+
+    // Appends the lines for a vehicle's AlertEdge flags, in the order raised/cleared
+    // overheating, then raised/cleared low fuel.
+    char* appendEdgeLines(char* out, int id, unsigned edges) {
+        if (edges & AlertEdge::OVERHEATING_RAISED) {
+            out = appendLine(out, id, OVERHEATING_SUFFIX, sizeof(OVERHEATING_SUFFIX) - 1);
+        }
+        if (edges & AlertEdge::OVERHEATING_CLEARED) {
+            out = appendLine(out, id, OVERHEATING_CLEARED_SUFFIX, sizeof(OVERHEATING_CLEARED_SUFFIX) - 1);
+        }
+        if (edges & AlertEdge::LOW_FUEL_RAISED) {
+            out = appendLine(out, id, LOW_FUEL_SUFFIX, sizeof(LOW_FUEL_SUFFIX) - 1);
+        }
+        if (edges & AlertEdge::LOW_FUEL_CLEARED) {
+            out = appendLine(out, id, LOW_FUEL_CLEARED_SUFFIX, sizeof(LOW_FUEL_CLEARED_SUFFIX) - 1);
+        }
+        return out;
+    }
+
+    char* appendMessageLine(char* out, int id, const std::string& message) {
+        out = append(out, ALERT_PREFIX);
+        out = std::to_chars(out, out + 11, id).ptr;
+        *out++ = ':';
+        *out++ = ' ';
+        std::memcpy(out, message.data(), message.size());
+        out += message.size();
+        *out++ = '\n';
+        return out;
+    }
+}
+
+std::size_t AlertMasks::overheatingCount() const { return popcount(overheating); }
+std::size_t AlertMasks::lowFuelCount() const { return popcount(lowFuel); }
+
+std::size_t AlertTransitions::count() const {
+    return raised.overheatingCount() + raised.lowFuelCount() + cleared.overheatingCount() + cleared.lowFuelCount();
+}
+
+/**
+ * @brief Evaluates the overheating and low fuel rules for every vehicle in the fleet.
+ *
+ * Each rule is a single vectorized threshold sweep over one metric column, producing one bit per
+ * slot. No formatting or I/O happens here, so evaluation cost depends only on fleet size.
+ *
+ * @param columns The fleet store to evaluate.
+ * @return Masks with bit i set when the vehicle in slot i triggers the corresponding rule.
+ */
+AlertMasks evaluateAlerts(const FleetColumns& columns) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::EvaluateAlerts);
+    AlertMasks masks;
+    masks.size = columns.size();
+    masks.overheating.resize(simd::maskWords(masks.size));
+    masks.lowFuel.resize(simd::maskWords(masks.size));
+    simd::maskGreater(columns.temperatures(), masks.size, AlertThresholds::CRITICAL_TEMP, masks.overheating.data());
+    simd::maskLess(columns.fuels(), masks.size, AlertThresholds::LOW_FUEL_THRESHOLD, masks.lowFuel.data());
+    return masks;
+}
+
+/**
+ * @brief Evaluates the alert rules in TaskPool::FLEET_CHUNK-sized chunks on a work-stealing pool.
+ *
+ * Chunks start on multiples of 64 slots, so each writes whole mask words of its own.
+ */
+AlertMasks evaluateAlerts(const FleetColumns& columns, TaskPool& pool) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::EvaluateAlerts);
+    AlertMasks masks;
+    masks.size = columns.size();
+    masks.overheating.resize(simd::maskWords(masks.size));
+    masks.lowFuel.resize(simd::maskWords(masks.size));
+    pool.parallelFor(masks.size, TaskPool::FLEET_CHUNK, [&](std::size_t first, std::size_t last) {
+        simd::maskGreater(columns.temperatures() + first, last - first, AlertThresholds::CRITICAL_TEMP,
+                          masks.overheating.data() + first / 64);
+        simd::maskLess(columns.fuels() + first, last - first, AlertThresholds::LOW_FUEL_THRESHOLD,
+                       masks.lowFuel.data() + first / 64);
+    });
+    return masks;
+}
+
+/**
+ * @brief Formats one line per set alert bit into the reporter's buffer.
+ *
+ * The buffer is sized once from the mask population counts, then only the set bits are visited.
+ * Lines appear in fleet order, with a vehicle's overheating alert before its low fuel warning,
+ * matching the layout FleetManager::checkAlerts has always printed.
+ *
+ * @param masks The alert masks produced by evaluateAlerts.
+ * @param ids The fleet id column, indexed by the same slots as the masks.
+ * @return The formatted alert text.
+ */
+const std::string& AlertReporter::format(const AlertMasks& masks, const int* ids) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::FormatAlerts);
+    lines = masks.overheatingCount() + masks.lowFuelCount();
+    buffer.resize(lines * MAX_LINE);
+    char* out = &buffer[0];
+    for (std::size_t w = 0; w < masks.overheating.size(); ++w) {
+        const std::uint64_t hot = masks.overheating[w];
+        const std::uint64_t low = masks.lowFuel[w];
+        for (std::uint64_t pending = hot | low; pending; pending &= pending - 1) {
+            int bit = simd::lowestBit(pending);
+            int id = ids[w * 64 + bit];
+            if (hot >> bit & 1) out = appendLine(out, id, OVERHEATING_SUFFIX, sizeof(OVERHEATING_SUFFIX) - 1);
+            if (low >> bit & 1) out = appendLine(out, id, LOW_FUEL_SUFFIX, sizeof(LOW_FUEL_SUFFIX) - 1);
+        }
+    }
+    buffer.resize(out - buffer.data());
+    return buffer;
+}
+
+// Grows or shrinks the state to `slots`; new slots have no active alerts.
+void AlertState::resize(std::size_t slots) {
+    const std::size_t words = simd::maskWords(slots);
+    slotIds.resize(slots, 0);
+    active.size = slots;
+    active.overheating.resize(words, 0);
+    active.lowFuel.resize(words, 0);
+    if (slots % 64 && words) {
+        const std::uint64_t valid = (std::uint64_t(1) << (slots % 64)) - 1;
+        active.overheating[words - 1] &= valid;
+        active.lowFuel[words - 1] &= valid;
+    }
+}
+
+/**
+ * @brief Re-evaluates every vehicle and returns only the alerts that changed state.
+ *
+ * An overheating alert is raised above CRITICAL_TEMP and stays active until the temperature drops
+ * below TEMP_CLEAR; a low fuel alert is raised below LOW_FUEL_THRESHOLD and stays active until
+ * fuel rises above FUEL_CLEAR. The four threshold masks come from the vectorized kernels, 4096
+ * slots at a time, and the new state is combined with the old one a 64-slot word at a time, so
+ * the pass costs about as much as evaluateAlerts while its output is proportional to the
+ * number of transitions, not to the number of alerting vehicles.
+ *
+ * @param columns The fleet store; slot i is matched against the state of slot i.
+ * @return The alerts raised and cleared since the previous update.
+ */
+AlertTransitions AlertState::update(const FleetColumns& columns) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::EvaluateAlerts);
+    constexpr std::size_t CHUNK = 4096;
+    constexpr std::size_t CHUNK_WORDS = CHUNK / 64;
+    const std::size_t size = columns.size();
+    resize(size);
+
+    AlertTransitions transitions;
+    for (AlertMasks* masks : {&transitions.raised, &transitions.cleared}) {
+        masks->size = size;
+        masks->overheating.resize(simd::maskWords(size));
+        masks->lowFuel.resize(simd::maskWords(size));
+    }
+
+    std::uint64_t hot[CHUNK_WORDS], cool[CHUNK_WORDS], low[CHUNK_WORDS], refuelled[CHUNK_WORDS];
+    for (std::size_t first = 0; first < size; first += CHUNK) {
+        const std::size_t count = std::min(CHUNK, size - first);
+        simd::maskGreater(columns.temperatures() + first, count, AlertThresholds::CRITICAL_TEMP, hot);
+        simd::maskLess(columns.temperatures() + first, count, AlertThresholds::TEMP_CLEAR, cool);
+        simd::maskLess(columns.fuels() + first, count, AlertThresholds::LOW_FUEL_THRESHOLD, low);
+        simd::maskGreater(columns.fuels() + first, count, AlertThresholds::FUEL_CLEAR, refuelled);
+
+        for (std::size_t w = 0; w < simd::maskWords(count); ++w) {
+            const std::size_t base = first + w * 64;
+            const std::size_t slots = std::min<std::size_t>(64, size - base);
+            std::uint64_t same = 0;
+            for (std::size_t b = 0; b < slots; ++b) {
+                same |= std::uint64_t(columns.ids()[base + b] == slotIds[base + b]) << b;
+            }
+
+            const std::size_t word = base / 64;
+            const std::uint64_t wasHot = active.overheating[word] & same;
+            const std::uint64_t isHot = hot[w] | (wasHot & ~cool[w]);
+            const std::uint64_t wasLow = active.lowFuel[word] & same;
+            const std::uint64_t isLow = low[w] | (wasLow & ~refuelled[w]);
+            transitions.raised.overheating[word] = isHot & ~wasHot;
+            transitions.cleared.overheating[word] = wasHot & ~isHot;
+            transitions.raised.lowFuel[word] = isLow & ~wasLow;
+            transitions.cleared.lowFuel[word] = wasLow & ~isLow;
+            active.overheating[word] = isHot;
+            active.lowFuel[word] = isLow;
+        }
+    }
+    std::copy(columns.ids(), columns.ids() + size, slotIds.begin());
+    return transitions;
+}
+
+/**
+ * @brief Applies one new reading to the state of a single slot.
+ *
+ * Same rules as the whole-fleet update, for callers such as streaming ingestion that see one
+ * reading at a time. The state grows to cover `slot` if needed.
+ *
+ * @param slot Fleet slot of the vehicle.
+ * @param id Identifier of the vehicle; a different id than last seen in the slot resets its state.
+ * @param temperature The new temperature reading.
+ * @param fuel The new fuel reading.
+ * @return The AlertEdge flags of the alerts raised or cleared by this reading, or 0.
+ */
+unsigned AlertState::update(std::size_t slot, int id, double temperature, double fuel) {
+    if (slot >= slotIds.size()) resize(slot + 1);
+    const std::size_t word = slot / 64;
+    const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+    const bool sameVehicle = slotIds[slot] == id;
+    slotIds[slot] = id;
+
+    const bool wasHot = sameVehicle && (active.overheating[word] & bit);
+    const bool wasLow = sameVehicle && (active.lowFuel[word] & bit);
+    const bool isHot = temperature > AlertThresholds::CRITICAL_TEMP ||
+                       (wasHot && !(temperature < AlertThresholds::TEMP_CLEAR));
+    const bool isLow = fuel < AlertThresholds::LOW_FUEL_THRESHOLD ||
+                       (wasLow && !(fuel > AlertThresholds::FUEL_CLEAR));
+    active.overheating[word] = isHot ? active.overheating[word] | bit : active.overheating[word] & ~bit;
+    active.lowFuel[word] = isLow ? active.lowFuel[word] | bit : active.lowFuel[word] & ~bit;
+
+    return (isHot && !wasHot ? AlertEdge::OVERHEATING_RAISED : 0u) |
+           (wasHot && !isHot ? AlertEdge::OVERHEATING_CLEARED : 0u) |
+           (isLow && !wasLow ? AlertEdge::LOW_FUEL_RAISED : 0u) |
+           (wasLow && !isLow ? AlertEdge::LOW_FUEL_CLEARED : 0u);
+}
+
+/**
+ * @brief Moves the state of slot `last` into `slot` and drops slot `last`.
+ *
+ * Call with the fleet's slot indices whenever FleetColumns::swapRemove moves its last vehicle into a
+ * freed slot, so that vehicle keeps its active alerts. Slots the state has not reached yet count as
+ * having no active alerts.
+ *
+ * @param slot The slot being removed.
+ * @param last The fleet's last slot, whose vehicle moves into `slot`.
+ */
+void AlertState::swapRemove(std::size_t slot, std::size_t last) {
+    if (slotIds.empty()) return;
+    if (last >= slotIds.size()) resize(last + 1);
+    if (slot != last) {
+        slotIds[slot] = slotIds[last];
+        const std::uint64_t bit = std::uint64_t(1) << (slot % 64);
+        const bool hot = active.isOverheating(last), low = active.hasLowFuel(last);
+        active.overheating[slot / 64] = hot ? active.overheating[slot / 64] | bit : active.overheating[slot / 64] & ~bit;
+        active.lowFuel[slot / 64] = low ? active.lowFuel[slot / 64] | bit : active.lowFuel[slot / 64] & ~bit;
+    }
+    resize(last);
+}
+
+void AlertState::clear() {
+    slotIds.clear();
+    active = AlertMasks();
+}
+
+/**
+ * @brief Formats one line per alert raised or cleared, in fleet order.
+ *
+ * Per vehicle the order is: overheating raised or cleared, then low fuel raised or cleared. Like
+ * the other overloads, the buffer is sized once and only set bits are visited.
+ *
+ * @param transitions The transitions produced by AlertState::update.
+ * @param ids The fleet id column, indexed by the same slots as the transitions.
+ * @return The formatted alert text.
+ */
+const std::string& AlertReporter::format(const AlertTransitions& transitions, const int* ids) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::FormatAlerts);
+    const AlertMasks& raised = transitions.raised;
+    const AlertMasks& cleared = transitions.cleared;
+    lines = transitions.count();
+    buffer.resize(lines * MAX_LINE);
+    char* out = &buffer[0];
+    for (std::size_t w = 0; w < raised.overheating.size(); ++w) {
+        const std::uint64_t pendingWord = raised.overheating[w] | cleared.overheating[w] | raised.lowFuel[w] |
+                                          cleared.lowFuel[w];
+        for (std::uint64_t pending = pendingWord; pending; pending &= pending - 1) {
+            const int bit = simd::lowestBit(pending);
+            const unsigned edges =
+                (raised.overheating[w] >> bit & 1 ? AlertEdge::OVERHEATING_RAISED : 0u) |
+                (cleared.overheating[w] >> bit & 1 ? AlertEdge::OVERHEATING_CLEARED : 0u) |
+                (raised.lowFuel[w] >> bit & 1 ? AlertEdge::LOW_FUEL_RAISED : 0u) |
+                (cleared.lowFuel[w] >> bit & 1 ? AlertEdge::LOW_FUEL_CLEARED : 0u);
+            out = appendEdgeLines(out, ids[w * 64 + bit], edges);
+        }
+    }
+    buffer.resize(out - buffer.data());
+    return buffer;
+}
+
+/**
+ * @brief Formats one `Vehicle ID <id>: <message>` line per matched rule into the reporter's buffer.
+ *
+ * Like the fixed-rule overload, the buffer is sized once from the mask population counts and only
+ * set bits are visited. Lines appear in fleet order and, per vehicle, in rule order, so the default
+ * rule set reproduces the fixed-rule output exactly.
+ *
+ * @param masks The masks produced by AlertRuleEngine::evaluate.
+ * @param rules The engine's rules, supplying each line's message.
+ * @param ids The fleet id column, indexed by the same slots as the masks.
+ * @return The formatted alert text.
+ */
+const std::string& AlertReporter::format(const RuleMasks& masks, const std::vector<AlertRule>& rules,
+                                         const int* ids) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::FormatAlerts);
+    std::size_t longest = 0;
+    for (const AlertRule& rule : rules) longest = std::max(longest, rule.message.size());
+    const std::size_t maxLine = sizeof(ALERT_PREFIX) - 1 + 11 + 2 + longest + 1;
+
+    lines = masks.total();
+    buffer.resize(lines * maxLine);
+    char* out = &buffer[0];
+    const std::size_t blocks = (masks.size + 63) / 64;
+    for (std::size_t w = 0; w < blocks; ++w) {
+        std::uint64_t pending = 0;
+        for (std::size_t r = 0; r < masks.rules; ++r) pending |= masks.word(w, r);
+        for (; pending; pending &= pending - 1) {
+            int bit = simd::lowestBit(pending);
+            int id = ids[w * 64 + bit];
+            for (std::size_t r = 0; r < masks.rules; ++r) {
+                if (!(masks.word(w, r) >> bit & 1)) continue;
+                out = appendMessageLine(out, id, rules[r].message);
+            }
+        }
+    }
+    buffer.resize(out - buffer.data());
+    return buffer;
+}
+
+/**
+ * @brief Appends the alert lines of a single vehicle to the buffer.
+ *
+ * Used by incremental callers (e.g. streaming ingestion) that evaluate one vehicle at a time
+ * and flush the accumulated text in batches.
+ *
+ * @param id Identifier of the vehicle.
+ * @param overheating Whether to emit the Critical Overheating line.
+ * @param lowFuel Whether to emit the Low Fuel Warning line.
+ */
+void AlertReporter::append(int id, bool overheating, bool lowFuel) {
+    if (!overheating && !lowFuel) return;
+    std::size_t used = buffer.size();
+    buffer.resize(used + 2 * MAX_LINE);
+    char* out = &buffer[used];
+    if (overheating) out = appendLine(out, id, OVERHEATING_SUFFIX, sizeof(OVERHEATING_SUFFIX) - 1);
+    if (lowFuel) out = appendLine(out, id, LOW_FUEL_SUFFIX, sizeof(LOW_FUEL_SUFFIX) - 1);
+    buffer.resize(out - buffer.data());
+    lines += overheating + lowFuel;
+}
+
+/**
+ * @brief Appends the transition lines of a single vehicle to the buffer.
+ *
+ * @param id Identifier of the vehicle.
+ * @param edges AlertEdge flags, as returned by AlertState::update for one slot.
+ */
+void AlertReporter::appendEdges(int id, unsigned edges) {
+    if (edges == 0) return;
+    std::size_t used = buffer.size();
+    buffer.resize(used + 2 * MAX_LINE);  // At most one overheating and one low fuel line
+    char* out = &buffer[used];
+    out = appendEdgeLines(out, id, edges);
+    buffer.resize(out - buffer.data());
+    lines += (edges & (AlertEdge::OVERHEATING_RAISED | AlertEdge::OVERHEATING_CLEARED)) != 0;
+    lines += (edges & (AlertEdge::LOW_FUEL_RAISED | AlertEdge::LOW_FUEL_CLEARED)) != 0;
+}
+
+/**
+ * @brief Appends one line per matched rule of a single vehicle to the buffer.
+ *
+ * @param id Identifier of the vehicle.
+ * @param matched Bit r set when rules[r] matched, as returned by AlertRuleEngine::evaluate for one reading.
+ * @param rules The engine's rules, for their messages.
+ */
+void AlertReporter::append(int id, std::uint64_t matched, const std::vector<AlertRule>& rules) {
+    if (matched == 0) return;
+    std::size_t needed = 0;
+    for (std::uint64_t pending = matched; pending; pending &= pending - 1) {
+        needed += sizeof(ALERT_PREFIX) - 1 + 11 + 2 + rules[simd::lowestBit(pending)].message.size() + 1;
+    }
+    std::size_t used = buffer.size();
+    buffer.resize(used + needed);
+    char* out = &buffer[used];
+    for (std::uint64_t pending = matched; pending; pending &= pending - 1) {
+        out = appendMessageLine(out, id, rules[simd::lowestBit(pending)].message);
+        ++lines;
+    }
+    buffer.resize(out - buffer.data());
+}
+
+/**
+ * @brief Writes the formatted alerts to a file descriptor.
+ *
+ * Pending std::cout / stdio output is flushed first so the alerts appear after anything already
+ * printed. The whole buffer goes out in a single write call; the loop only repeats if the kernel
+ * accepts a partial write (e.g. a full pipe).
+ *
+ * @param fd Destination file descriptor (standard output by default).
+ *
+ * @throws std::runtime_error If the write fails.
+ */
+void AlertReporter::write(int fd) const {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::WriteAlerts);
+    std::cout.flush();
+    std::fflush(stdout);
+
+    const char* data = buffer.data();
+    std::size_t remaining = buffer.size();
+    while (remaining > 0) {
+#ifdef _WIN32
+        int written = ::_write(fd, data, static_cast<unsigned>(remaining));
+#else
+        ssize_t written = ::write(fd, data, remaining);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Unable to write alerts");
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+    instrumentation::add(instrumentation::Counter::AlertsEmitted, lines);
+}
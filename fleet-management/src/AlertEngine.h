@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FleetColumns.h"
+
+// Constants for thresholds
+namespace AlertThresholds {
+    constexpr double CRITICAL_TEMP = 110.0;
+    constexpr double LOW_FUEL_THRESHOLD = 15.0;
+    // Hysteresis for edge-triggered alerts: an active alert clears only once the
+    // reading is back past these, so values hovering at a threshold do not flap.
+    constexpr double TEMP_CLEAR = 105.0;
+    constexpr double FUEL_CLEAR = 17.0;
+}
+
+// Transition flags returned by AlertState for one vehicle.
+namespace AlertEdge {
+    constexpr unsigned OVERHEATING_RAISED = 1;
+    constexpr unsigned OVERHEATING_CLEARED = 2;
+    constexpr unsigned LOW_FUEL_RAISED = 4;
+    constexpr unsigned LOW_FUEL_CLEARED = 8;
+}
+
+struct AlertRule;
+class TaskPool;
+struct RuleMasks;
+
+// One bit per fleet slot for each alert rule, packed into 64-bit words.
+struct AlertMasks {
+    std::size_t size{0};
+    std::vector<std::uint64_t> overheating;
+    std::vector<std::uint64_t> lowFuel;
+
+    std::size_t overheatingCount() const;
+    std::size_t lowFuelCount() const;
+    bool isOverheating(std::size_t slot) const { return overheating[slot / 64] >> (slot % 64) & 1; }
+    bool hasLowFuel(std::size_t slot) const { return lowFuel[slot / 64] >> (slot % 64) & 1; }
+};
+
+// Evaluates every alert rule over the whole fleet without producing any output.
+AlertMasks evaluateAlerts(const FleetColumns& columns);
+AlertMasks evaluateAlerts(const FleetColumns& columns, TaskPool& pool);  // Chunked on the pool
+
+// Alerts raised and cleared by one AlertState update, one bit per fleet slot.
+struct AlertTransitions {
+    AlertMasks raised;
+    AlertMasks cleared;
+
+    std::size_t count() const;
+};
+
+// Edge-triggered alert state: one bit per fleet slot for each rule, so an alert
+// is reported once when it is raised and once when it clears instead of on every
+// check. Raising uses the alert thresholds and clearing the hysteresis bounds in
+// AlertThresholds. Slots must follow the fleet's (FleetManager keeps its own state
+// in step through swapRemove); a slot found holding a different id than last seen
+// starts again with no active alerts.
+class AlertState {
+private:
+    std::vector<int> slotIds;
+    AlertMasks active;
+
+    void resize(std::size_t slots);
+
+public:
+    AlertTransitions update(const FleetColumns& columns);  // Whole fleet
+    unsigned update(std::size_t slot, int id, double temperature, double fuel);  // AlertEdge flags
+    void swapRemove(std::size_t slot, std::size_t last);  // Mirrors FleetColumns::swapRemove
+    const AlertMasks& activeAlerts() const { return active; }
+    void clear();
+};
+
+// Turns alert masks into text in one pre-sized buffer and emits it with a single write.
+class AlertReporter {
+private:
+    std::string buffer;
+    std::size_t lines{0};
+
+public:
+    const std::string& format(const AlertMasks& masks, const int* ids);
+    const std::string& format(const RuleMasks& masks, const std::vector<AlertRule>& rules, const int* ids);
+    const std::string& format(const AlertTransitions& transitions, const int* ids);
+    void append(int id, bool overheating, bool lowFuel);
+    void appendEdges(int id, unsigned edges);  // AlertEdge flags
+    void append(int id, std::uint64_t matched, const std::vector<AlertRule>& rules);  // Bit r: rules[r]
+    void clear() { buffer.clear(); lines = 0; }
+    bool empty() const { return buffer.empty(); }
+    const std::string& text() const { return buffer; }
+    std::size_t lineCount() const { return lines; }
+    void write(int fd = 1) const;
+};
@@ -0,0 +1,326 @@
+#include "AlertRules.h"
+#include "AlertEngine.h"
+#include "Instrumentation.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define FLEET_RULES_SSE2 1
+#include <emmintrin.h>
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define FLEET_RULES_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // One slot of the predicate for a rule kind. NaN never matches.
+    template<RuleKind Kind>
+    bool ruleHit(double value, double base, double threshold) {
+        if constexpr (Kind == RuleKind::Above) return value > threshold;
+        else if constexpr (Kind == RuleKind::Below) return value < threshold;
+        else if constexpr (Kind == RuleKind::RiseAbove) return value - base > threshold;
+        else return base - value > threshold;
+    }
+
+    // Predicate over one block of up to 64 slots: bit i is set when slot i matches. N is the block
+    // length when it is known at compile time (full blocks), 0 otherwise. The comparison for the rule
+    // kind is inlined, so a full-block instantiation is a fixed 64-slot compare-and-pack with no calls
+    // and no branches; on x86-64 it compares two slots per SSE2 instruction (part of the baseline
+    // ISA, so no dispatch is needed), elsewhere the scalar loop is left to the compiler.
+    template<RuleKind Kind, std::size_t N>
+    std::uint64_t ruleKernel(const double* values, const double* baseline, double threshold, std::size_t n) {
+        const std::size_t count = N ? N : n;
+        std::uint64_t word = 0;
+        std::size_t i = 0;
+#ifdef FLEET_RULES_SSE2
+        const __m128d limit = _mm_set1_pd(threshold);
+        for (; i + 2 <= count; i += 2) {
+            __m128d v = _mm_loadu_pd(values + i);
+            __m128d hit;
+            if constexpr (Kind == RuleKind::Above) {
+                hit = _mm_cmpgt_pd(v, limit);
+            } else if constexpr (Kind == RuleKind::Below) {
+                hit = _mm_cmplt_pd(v, limit);
+            } else if constexpr (Kind == RuleKind::RiseAbove) {
+                hit = _mm_cmpgt_pd(_mm_sub_pd(v, _mm_loadu_pd(baseline + i)), limit);
+            } else {
+                hit = _mm_cmpgt_pd(_mm_sub_pd(_mm_loadu_pd(baseline + i), v), limit);
+            }
+            word |= static_cast<std::uint64_t>(_mm_movemask_pd(hit)) << i;
+        }
+#endif
+        for (; i < count; ++i) {
+            word |= static_cast<std::uint64_t>(ruleHit<Kind>(values[i], baseline ? baseline[i] : 0.0, threshold)) << i;
+        }
+        return word;
+    }
+
+#ifdef FLEET_RULES_AVX2
+    // The full-block kernel again, four slots per instruction, for CPUs with AVX2 (see kernelsFor).
+    template<RuleKind Kind>
+    __attribute__((target("avx2")))
+    std::uint64_t ruleKernelAvx2(const double* values, const double* baseline, double threshold, std::size_t) {
+        const __m256d limit = _mm256_set1_pd(threshold);
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < 64; i += 4) {
+            __m256d v = _mm256_loadu_pd(values + i);
+            __m256d hit;
+            if constexpr (Kind == RuleKind::Above) {
+                hit = _mm256_cmp_pd(v, limit, _CMP_GT_OQ);
+            } else if constexpr (Kind == RuleKind::Below) {
+                hit = _mm256_cmp_pd(v, limit, _CMP_LT_OQ);
+            } else if constexpr (Kind == RuleKind::RiseAbove) {
+                hit = _mm256_cmp_pd(_mm256_sub_pd(v, _mm256_loadu_pd(baseline + i)), limit, _CMP_GT_OQ);
+            } else {
+                hit = _mm256_cmp_pd(_mm256_sub_pd(_mm256_loadu_pd(baseline + i), v), limit, _CMP_GT_OQ);
+            }
+            word |= static_cast<std::uint64_t>(_mm256_movemask_pd(hit)) << i;
+        }
+        return word;
+    }
+#endif
+
+    // Full- and partial-block kernels for a rule kind; the full-block one uses AVX2 when the
+    // runtime-dispatched SIMD kernels do.
+    template<RuleKind Kind>
+    std::pair<AlertRuleEngine::Kernel, AlertRuleEngine::Kernel> kernelsFor() {
+#ifdef FLEET_RULES_AVX2
+        if (std::strcmp(simd::activeIsa(), "avx2") == 0) return {ruleKernelAvx2<Kind>, ruleKernel<Kind, 0>};
+#endif
+        return {ruleKernel<Kind, 64>, ruleKernel<Kind, 0>};
+    }
+
+    // Slots whose baseline was taken from the same vehicle; delta rules only apply there.
+    std::uint64_t sameVehicleMask(const int* ids, const int* baselineIds, std::size_t n) {
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < n; ++i) word |= static_cast<std::uint64_t>(ids[i] == baselineIds[i]) << i;
+        return word;
+    }
+
+    std::size_t popcount(std::uint64_t w) {
+        std::size_t bits = 0;
+        for (; w; w &= w - 1) ++bits;
+        return bits;
+    }
+
+    bool parseMetric(const std::string& text, Metric& metric) {
+        if (text == "speed") metric = Metric::Speed;
+        else if (text == "temperature") metric = Metric::Temperature;
+        else if (text == "fuel") metric = Metric::Fuel;
+        else return false;
+        return true;
+    }
+
+    bool parseKind(const std::string& text, RuleKind& kind) {
+        if (text == ">") kind = RuleKind::Above;
+        else if (text == "<") kind = RuleKind::Below;
+        else if (text == "rise") kind = RuleKind::RiseAbove;
+        else if (text == "drop") kind = RuleKind::DropAbove;
+        else return false;
+        return true;
+    }
+}
+
+std::size_t RuleMasks::count(std::size_t rule) const {
+    std::size_t bits = 0;
+    for (std::size_t w = 0; w * rules < words.size(); ++w) bits += popcount(word(w, rule));
+    return bits;
+}
+
+std::size_t RuleMasks::total() const {
+    std::size_t bits = 0;
+    for (std::uint64_t w : words) bits += popcount(w);
+    return bits;
+}
+
+/**
+ * @brief Returns the built-in rule set: overheating above CRITICAL_TEMP and fuel below LOW_FUEL_THRESHOLD.
+ *
+ * Formatting these rules produces exactly the alert lines of FleetManager::checkAlerts.
+ */
+std::vector<AlertRule> defaultAlertRules() {
+    return {
+        {"overheating", Metric::Temperature, RuleKind::Above, AlertThresholds::CRITICAL_TEMP, "Critical Overheating"},
+        {"low_fuel", Metric::Fuel, RuleKind::Below, AlertThresholds::LOW_FUEL_THRESHOLD, "Low Fuel Warning"},
+    };
+}
+
+/**
+ * @brief Parses a rule configuration.
+ *
+ * Each non-blank, non-comment line is `name metric op threshold [message...]`, e.g.
+ * `overspeed speed > 120 Overspeed`. The message defaults to the rule name.
+ *
+ * @param in Stream holding the configuration.
+ * @return The rules in configuration order.
+ *
+ * @throws std::runtime_error If a line is malformed, naming the line number.
+ */
+std::vector<AlertRule> parseAlertRules(std::istream& in) {
+    std::vector<AlertRule> rules;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        std::istringstream fields(line);
+        AlertRule rule;
+        std::string metric, op;
+        if (!(fields >> rule.name) || rule.name[0] == '#') continue;
+        if (!(fields >> metric >> op >> rule.threshold) || !parseMetric(metric, rule.metric)
+            || !parseKind(op, rule.kind)) {
+            throw std::runtime_error("Invalid alert rule at line " + std::to_string(number) + ": " + line);
+        }
+        std::getline(fields >> std::ws, rule.message);
+        while (!rule.message.empty() && (rule.message.back() == '\r' || rule.message.back() == ' ')) {
+            rule.message.pop_back();
+        }
+        if (rule.message.empty()) rule.message = rule.name;
+        rules.push_back(std::move(rule));
+    }
+    return rules;
+}
+
+/**
+ * @brief Reads a rule configuration file; see parseAlertRules for the format.
+ *
+ * @throws std::runtime_error If the file cannot be opened or a line is malformed.
+ */
+std::vector<AlertRule> loadAlertRules(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+    return parseAlertRules(in);
+}
+
+/**
+ * @brief Binds every rule to the predicate kernel specialized for its kind.
+ *
+ * The kind is dispatched once here, so evaluation makes one indirect call per rule per 64 slots
+ * and the kernels themselves contain no branches on rule configuration or per slot.
+ *
+ * @param rules The rules to evaluate, in reporting order.
+ */
+AlertRuleEngine::AlertRuleEngine(std::vector<AlertRule> rules) : ruleSet(std::move(rules)) {
+    for (const AlertRule& rule : ruleSet) {
+        std::pair<Kernel, Kernel> kernels;
+        switch (rule.kind) {
+            case RuleKind::Above: kernels = kernelsFor<RuleKind::Above>(); break;
+            case RuleKind::Below: kernels = kernelsFor<RuleKind::Below>(); break;
+            case RuleKind::RiseAbove: kernels = kernelsFor<RuleKind::RiseAbove>(); break;
+            case RuleKind::DropAbove: kernels = kernelsFor<RuleKind::DropAbove>(); break;
+        }
+        bool delta = rule.kind == RuleKind::RiseAbove || rule.kind == RuleKind::DropAbove;
+        usesBaseline = usesBaseline || delta;
+        compiled.push_back({rule.metric, rule.threshold, delta, kernels.first, kernels.second});
+    }
+}
+
+/**
+ * @brief Evaluates every rule against a single reading, for callers that apply readings one at a time.
+ *
+ * Used by streaming ingestion, where a vehicle's previous reading is its baseline: rise/drop rules
+ * compare each new reading with the one it replaces.
+ *
+ * @param reading Speed, temperature and fuel of the new reading.
+ * @param previous The vehicle's previous speed, temperature and fuel, or nullptr for a new vehicle.
+ * @return One bit per rule, in rule order.
+ *
+ * @throws std::length_error If there are more than MAX_READING_RULES rules.
+ */
+std::uint64_t AlertRuleEngine::evaluate(const double* reading, const double* previous) const {
+    if (compiled.size() > MAX_READING_RULES) {
+        throw std::length_error("At most " + std::to_string(MAX_READING_RULES) + " rules per reading");
+    }
+    std::uint64_t matched = 0;
+    for (std::size_t r = 0; r < compiled.size(); ++r) {
+        const CompiledRule& rule = compiled[r];
+        const int m = static_cast<int>(rule.metric);
+        bool hit;
+        switch (ruleSet[r].kind) {
+            case RuleKind::Above: hit = ruleHit<RuleKind::Above>(reading[m], 0.0, rule.threshold); break;
+            case RuleKind::Below: hit = ruleHit<RuleKind::Below>(reading[m], 0.0, rule.threshold); break;
+            case RuleKind::RiseAbove:
+                hit = previous && ruleHit<RuleKind::RiseAbove>(reading[m], previous[m], rule.threshold);
+                break;
+            default:
+                hit = previous && ruleHit<RuleKind::DropAbove>(reading[m], previous[m], rule.threshold);
+                break;
+        }
+        matched |= static_cast<std::uint64_t>(hit) << r;
+    }
+    return matched;
+}
+
+/**
+ * @brief Evaluates every rule over the fleet in a single pass.
+ *
+ * The fleet is walked in 64-slot blocks; each block's metric values (and baseline values, for delta
+ * rules) are run through all rule kernels before moving on, so adding a rule adds work per block
+ * rather than another scan of the fleet. Delta rules only fire for slots whose baseline was taken
+ * from the same vehicle id; slots beyond the baseline or reassigned since never match them.
+ *
+ * @param columns The fleet store to evaluate.
+ * @return Word-major masks with one bit per slot and rule.
+ */
+RuleMasks AlertRuleEngine::evaluate(const FleetColumns& columns) const {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::EvaluateAlerts);
+    RuleMasks masks;
+    masks.size = columns.size();
+    masks.rules = compiled.size();
+    const std::size_t blocks = (masks.size + 63) / 64;
+    masks.words.resize(blocks * masks.rules);
+
+    const double* current[] = {columns.speeds(), columns.temperatures(), columns.fuels()};
+    const double* baseline[] = {baselineSpeeds.data(), baselineTemperatures.data(), baselineFuels.data()};
+    const std::size_t baselineSize = usesBaseline ? baselineIds.size() : 0;
+
+    std::uint64_t* out = masks.words.data();
+    for (std::size_t w = 0; w < blocks; ++w, out += masks.rules) {
+        const std::size_t first = w * 64;
+        const std::size_t n = std::min<std::size_t>(64, masks.size - first);
+        const std::size_t known = first < baselineSize ? std::min(n, baselineSize - first) : 0;
+        const std::uint64_t sameVehicle =
+            known ? sameVehicleMask(columns.ids() + first, baselineIds.data() + first, known) : 0;
+
+        for (std::size_t r = 0; r < compiled.size(); ++r) {
+            const CompiledRule& rule = compiled[r];
+            const int m = static_cast<int>(rule.metric);
+            if (!rule.delta) {
+                out[r] = (n == 64 ? rule.fullBlock : rule.partialBlock)(current[m] + first, nullptr, rule.threshold, n);
+            } else if (known) {
+                out[r] = sameVehicle & (known == 64 ? rule.fullBlock : rule.partialBlock)(
+                    current[m] + first, baseline[m] + first, rule.threshold, known);
+            }
+        }
+    }
+    return masks;
+}
+
+/**
+ * @brief Records the fleet's current readings as the baseline for delta rules.
+ *
+ * Call after each evaluation (or each batch of updates) so the next evaluation measures change
+ * since then. Does nothing if no rule compares against a baseline.
+ *
+ * @param columns The fleet store whose readings become the baseline.
+ */
+void AlertRuleEngine::updateBaseline(const FleetColumns& columns) {
+    if (!usesBaseline) return;
+    const std::size_t size = columns.size();
+    baselineIds.assign(columns.ids(), columns.ids() + size);
+    baselineSpeeds.assign(columns.speeds(), columns.speeds() + size);
+    baselineTemperatures.assign(columns.temperatures(), columns.temperatures() + size);
+    baselineFuels.assign(columns.fuels(), columns.fuels() + size);
+}
+
+void AlertRuleEngine::clearBaseline() {
+    baselineIds.clear();
+    baselineSpeeds.clear();
+    baselineTemperatures.clear();
+    baselineFuels.clear();
+}
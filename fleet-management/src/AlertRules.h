@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include "FleetColumns.h"
+
+// Above/Below compare the current reading with the threshold; RiseAbove/DropAbove
+// compare how far it moved since the engine's baseline for the same vehicle.
+enum class RuleKind { Above, Below, RiseAbove, DropAbove };
+
+struct AlertRule {
+    std::string name;
+    Metric metric;
+    RuleKind kind;
+    double threshold;
+    std::string message;  // Alert text after "Vehicle ID <id>: "
+};
+
+// The overheating and low fuel rules of AlertThresholds, with their usual messages.
+std::vector<AlertRule> defaultAlertRules();
+
+// Rule configuration, one rule per line: `name metric op threshold [message...]`
+// with metric speed|temperature|fuel and op > | < | rise | drop. Blank lines and
+// lines starting with '#' are ignored.
+std::vector<AlertRule> parseAlertRules(std::istream& in);
+std::vector<AlertRule> loadAlertRules(const std::string& filename);
+
+// One bit per (slot, rule), stored word-major: the mask words of all rules for
+// slots [64w, 64w + 64) are adjacent, so a vehicle's alerts are read together.
+struct RuleMasks {
+    std::size_t size{0};
+    std::size_t rules{0};
+    std::vector<std::uint64_t> words;
+
+    std::uint64_t word(std::size_t w, std::size_t rule) const { return words[w * rules + rule]; }
+    bool test(std::size_t slot, std::size_t rule) const { return word(slot / 64, rule) >> (slot % 64) & 1; }
+    std::size_t count(std::size_t rule) const;
+    std::size_t total() const;
+};
+
+// Evaluates any number of rules in one fused pass over the fleet. Each rule is bound
+// at construction to a predicate kernel specialized for its kind, and every 64-slot
+// block is run through all kernels while it is in cache.
+class AlertRuleEngine {
+public:
+    static constexpr std::size_t MAX_READING_RULES = 64;
+    using Kernel = std::uint64_t (*)(const double* values, const double* baseline, double threshold, std::size_t n);
+
+private:
+    struct CompiledRule {
+        Metric metric;
+        double threshold;
+        bool delta;
+        Kernel fullBlock;
+        Kernel partialBlock;
+    };
+
+    std::vector<AlertRule> ruleSet;
+    std::vector<CompiledRule> compiled;
+    bool usesBaseline{false};
+    std::vector<int> baselineIds;
+    std::vector<double> baselineSpeeds;
+    std::vector<double> baselineTemperatures;
+    std::vector<double> baselineFuels;
+
+public:
+    explicit AlertRuleEngine(std::vector<AlertRule> rules = defaultAlertRules());
+
+    const std::vector<AlertRule>& rules() const { return ruleSet; }
+    RuleMasks evaluate(const FleetColumns& columns) const;
+    // One vehicle: bit r is set when rule r matches. `reading` and `previous` are
+    // speed, temperature and fuel; `previous` (the vehicle's reading at its last
+    // check) may be nullptr, in which case rise/drop rules do not match. At most
+    // MAX_READING_RULES rules.
+    std::uint64_t evaluate(const double* reading, const double* previous) const;
+    void updateBaseline(const FleetColumns& columns);
+    void clearBaseline();
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Standard allocator whose blocks start on an `Alignment`-byte boundary, so that
+// arrays split into cache-line multiples keep every part on its own lines.
+template<typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
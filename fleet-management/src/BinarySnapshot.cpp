@@ -0,0 +1,146 @@
+#include "BinarySnapshot.h"
+#include "Instrumentation.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    constexpr char SNAPSHOT_MAGIC[8] = {'F', 'L', 'E', 'E', 'T', 'S', 'N', 'P'};
+    constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint64_t COLUMN_ALIGNMENT = 64;
+
+    static_assert(sizeof(SnapshotHeader) == 64, "snapshot header must stay 64 bytes");
+    static_assert(sizeof(int) == sizeof(std::int32_t), "ids are stored as int32");
+
+    std::uint64_t alignUp(std::uint64_t offset) {
+        return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+    }
+
+    void writeColumn(std::ofstream& out, const void* data, std::uint64_t bytes, std::uint64_t offset) {
+        static const char padding[COLUMN_ALIGNMENT] = {};
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        out.write(padding, static_cast<std::streamsize>(offset - position));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+}
+
+/**
+ * @brief Builds the header of a snapshot holding `count` vehicles.
+ *
+ * Columns follow the header in id, speed, temperature, fuel order, each starting at the next
+ * 64-byte boundary; the file ends with the last fuel value.
+ *
+ * @param count Number of vehicles in the snapshot.
+ * @return The filled-in header.
+ */
+SnapshotHeader makeSnapshotHeader(std::uint64_t count) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.count = count;
+    header.idOffset = alignUp(sizeof(SnapshotHeader));
+    header.speedOffset = alignUp(header.idOffset + count * sizeof(std::int32_t));
+    header.temperatureOffset = alignUp(header.speedOffset + count * sizeof(double));
+    header.fuelOffset = alignUp(header.temperatureOffset + count * sizeof(double));
+    return header;
+}
+
+/**
+ * @brief Writes the fleet columns to a binary snapshot file.
+ *
+ * The header records the format version, a byte-order mark and the offset of each column;
+ * the columns are then written verbatim, each padded to a 64-byte boundary.
+ *
+ * @param columns The fleet store to save.
+ * @param filename Path of the snapshot file to create or overwrite.
+ *
+ * @throws std::runtime_error If the file cannot be created or written.
+ */
+void writeBinarySnapshot(const FleetColumns& columns, const std::string& filename) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::WriteSnapshot);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Unable to create snapshot: " + filename);
+    }
+
+    const std::uint64_t count = columns.size();
+    const SnapshotHeader header = makeSnapshotHeader(count);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeColumn(out, columns.ids(), count * sizeof(std::int32_t), header.idOffset);
+    writeColumn(out, columns.speeds(), count * sizeof(double), header.speedOffset);
+    writeColumn(out, columns.temperatures(), count * sizeof(double), header.temperatureOffset);
+    writeColumn(out, columns.fuels(), count * sizeof(double), header.fuelOffset);
+
+    if (!out) {
+        throw std::runtime_error("Unable to write snapshot: " + filename);
+    }
+}
+
+/**
+ * @brief Maps a snapshot file and validates its header.
+ *
+ * Nothing is parsed or copied: the column accessors point straight into the mapping, so opening
+ * a snapshot costs only the page faults of the data that is actually touched.
+ *
+ * @param filename Path of the snapshot file.
+ *
+ * @throws std::runtime_error If the file cannot be mapped, is not a snapshot, was written with
+ *         another format version or byte order, or is shorter than its header claims.
+ */
+SnapshotView::SnapshotView(const std::string& filename) : file(filename) {
+    if (file.size() < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Not a fleet snapshot: " + filename);
+    }
+    header = reinterpret_cast<const SnapshotHeader*>(file.data());
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        throw std::runtime_error("Not a fleet snapshot: " + filename);
+    }
+    if (header->version != SNAPSHOT_VERSION || header->byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Unsupported snapshot version or byte order: " + filename);
+    }
+
+    const std::uint64_t count = header->count;
+    const std::uint64_t offsets[] = {header->idOffset, header->speedOffset, header->temperatureOffset,
+                                     header->fuelOffset};
+    const std::uint64_t widths[] = {sizeof(std::int32_t), sizeof(double), sizeof(double), sizeof(double)};
+    for (int i = 0; i < 4; ++i) {
+        if (offsets[i] % COLUMN_ALIGNMENT != 0 || offsets[i] > file.size()
+            || count > (file.size() - offsets[i]) / widths[i]) {
+            throw std::runtime_error("Truncated or corrupt snapshot: " + filename);
+        }
+    }
+}
+
+const std::int32_t* SnapshotView::ids() const {
+    return reinterpret_cast<const std::int32_t*>(file.data() + header->idOffset);
+}
+
+const double* SnapshotView::speeds() const {
+    return reinterpret_cast<const double*>(file.data() + header->speedOffset);
+}
+
+const double* SnapshotView::temperatures() const {
+    return reinterpret_cast<const double*>(file.data() + header->temperatureOffset);
+}
+
+const double* SnapshotView::fuels() const {
+    return reinterpret_cast<const double*>(file.data() + header->fuelOffset);
+}
+
+/**
+ * @brief Copies the mapped columns into an owning FleetColumns store.
+ *
+ * Each column is copied as one contiguous block, so the cost is bounded by memory bandwidth
+ * and page faults rather than by any per-vehicle work.
+ *
+ * @return A FleetColumns holding the snapshot's vehicles in stored order.
+ */
+FleetColumns SnapshotView::toColumns() const {
+    instrumentation::add(instrumentation::Counter::BytesRead,
+                         size() * (sizeof(std::int32_t) + 3 * sizeof(double)));
+    FleetColumns columns;
+    columns.assign(ids(), speeds(), temperatures(), fuels(), size());
+    return columns;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "FleetColumns.h"
+#include "MappedFile.h"
+
+// Versioned binary columnar snapshot of a fleet:
+//
+//   [SnapshotHeader, 64 bytes][ids][speeds][temperatures][fuels]
+//
+// Every column starts on a 64-byte boundary and holds `count` native-endian
+// values (int32 ids, IEEE-754 doubles), so a mapped snapshot can be used in place.
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t count;
+    std::uint64_t idOffset;
+    std::uint64_t speedOffset;
+    std::uint64_t temperatureOffset;
+    std::uint64_t fuelOffset;
+    std::uint64_t reserved;
+};
+
+// Header (magic, version, column offsets) of a snapshot holding `count` vehicles,
+// for writers that emit the columns themselves.
+SnapshotHeader makeSnapshotHeader(std::uint64_t count);
+
+void writeBinarySnapshot(const FleetColumns& columns, const std::string& filename);
+
+// Read-only, zero-copy view of a mapped snapshot file.
+class SnapshotView {
+private:
+    MappedFile file;
+    const SnapshotHeader* header{nullptr};
+
+public:
+    explicit SnapshotView(const std::string& filename);
+
+    std::size_t size() const { return static_cast<std::size_t>(header->count); }
+    const std::int32_t* ids() const;
+    const double* speeds() const;
+    const double* temperatures() const;
+    const double* fuels() const;
+
+    FleetColumns toColumns() const;
+};
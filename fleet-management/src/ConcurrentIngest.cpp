@@ -0,0 +1,188 @@
+#include "ConcurrentIngest.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // Most readings taken from one queue before moving to the next, so one busy producer
+    // cannot starve the others and each head update frees a batch of slots at once.
+    constexpr std::size_t DRAIN_BATCH = 256;
+
+    // Consecutive empty polls, each followed by a yield, before the applier goes to sleep. Keeps
+    // a bursty stream on the spinning path while an idle one stops costing a core.
+    constexpr std::size_t SPIN_POLLS = 1024;
+}
+
+/**
+ * @brief Pushes a reading, yielding the thread while the queue is full.
+ *
+ * A full queue means the applier is behind; waiting here applies back-pressure to the producer
+ * instead of dropping readings or growing memory without bound.
+ *
+ * @param reading The reading to enqueue.
+ */
+void ConcurrentIngest::Producer::push(const TelemetryReading& reading) {
+    while (!tryPush(reading)) std::this_thread::yield();
+}
+
+/**
+ * @brief Creates one queue per producer; the applier is not started yet.
+ *
+ * @param fleet The fleet the readings are applied to.
+ * @param producers Number of producer threads that will push readings.
+ * @param queueCapacity Readings each producer can have in flight; rounded up to a power of two.
+ *
+ * @throws std::invalid_argument If producers or queueCapacity is zero.
+ */
+ConcurrentIngest::ConcurrentIngest(FleetManager& fleet, std::size_t producers, std::size_t queueCapacity)
+    : fleet(fleet) {
+    if (producers == 0) throw std::invalid_argument("Ingestion needs at least one producer");
+    queues.reserve(producers);
+    for (std::size_t i = 0; i < producers; ++i) {
+        queues.push_back(std::make_unique<SpscQueue<TelemetryReading>>(queueCapacity));
+    }
+}
+
+ConcurrentIngest::~ConcurrentIngest() {
+    stop();
+}
+
+/**
+ * @brief Makes the applier publish read views of the fleet while it runs.
+ *
+ * A view is published after every `everyReadings` applied readings and when the applier stops.
+ * Readings that trickle in below that rate are published once the queues run dry, but no sooner
+ * than `minGap` after the previous view: each publish copies the whole fleet, so without the gap
+ * a slow stream would cost one fleet copy per reading. Call before start().
+ *
+ * @param views Store the views are published to; this thread becomes its only writer.
+ * @param everyReadings Most readings applied between two views.
+ * @param minGap Least time between two views published while the queues are dry.
+ */
+void ConcurrentIngest::publishViews(FleetViewStore& views, std::size_t everyReadings,
+                                    std::chrono::milliseconds minGap) {
+    if (running()) throw std::logic_error("publishViews must be called before start");
+    this->views = &views;
+    publishInterval = std::max<std::size_t>(1, everyReadings);
+    publishGap = std::max(minGap, std::chrono::milliseconds::zero());
+}
+
+/**
+ * @brief Starts the applier thread. From now until stop() the fleet belongs to it.
+ */
+void ConcurrentIngest::start() {
+    if (running()) return;
+    stopping.store(false, std::memory_order_relaxed);
+    applier = std::thread(&ConcurrentIngest::applyLoop, this);
+}
+
+/**
+ * @brief Signals the applier to finish and waits for it.
+ *
+ * Every reading whose push returned before this call is applied before the applier exits. Pushes
+ * racing with stop() may or may not be applied, so producers should be joined first.
+ */
+void ConcurrentIngest::stop() {
+    if (!running()) return;
+    stopping.store(true, std::memory_order_release);
+    wake();
+    applier.join();
+}
+
+// Takes one batch from every queue in turn; returns the number of readings applied.
+std::size_t ConcurrentIngest::drainAll() {
+    std::size_t total = 0;
+    for (auto& queue : queues) {
+        total += queue->drain([this](const TelemetryReading& r) {
+            fleet.upsertReading(r.id, r.speed, r.temperature, r.fuel);
+        }, DRAIN_BATCH);
+    }
+    if (total) readingsApplied.fetch_add(total, std::memory_order_relaxed);
+    return total;
+}
+
+bool ConcurrentIngest::queuesEmpty() const {
+    return std::all_of(queues.begin(), queues.end(), [](const auto& queue) { return queue->empty(); });
+}
+
+/**
+ * @brief Blocks the applier until a producer pushes a reading, stop() is called, or `until` passes.
+ *
+ * The applier announces that it is asleep and then checks the queues once more, so a reading pushed
+ * just before the announcement is not left waiting: its producer either saw the flag and will wake
+ * the applier, or pushed before the re-check and the applier does not sleep at all.
+ *
+ * @param until When the applier has to wake on its own (to publish pending readings); none to wait
+ *              for a push only.
+ */
+void ConcurrentIngest::sleep(std::optional<std::chrono::steady_clock::time_point> until) {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!queuesEmpty() || stopping.load(std::memory_order_acquire)) {
+        sleeping.store(false, std::memory_order_relaxed);
+        return;
+    }
+    auto woken = [this] { return !sleeping.load(std::memory_order_relaxed); };
+    if (until) {
+        wakeUp.wait_until(lock, *until, woken);
+    } else {
+        wakeUp.wait(lock, woken);
+    }
+    sleeping.store(false, std::memory_order_relaxed);
+}
+
+void ConcurrentIngest::wake() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+    wakeUp.notify_one();
+}
+
+/**
+ * @brief Applier thread: drains the queues until stop(), publishing views as configured.
+ *
+ * While readings arrive the loop polls the queues and yields between empty polls; after SPIN_POLLS
+ * empty polls in a row it sleeps until the next push, or until pending readings are due to be
+ * published. Views retired by earlier publishes are reclaimed before sleeping, so an idle applier
+ * does not hold on to old fleet copies.
+ */
+void ConcurrentIngest::applyLoop() {
+    using Clock = std::chrono::steady_clock;
+    std::size_t unpublished = 0;
+    std::size_t emptyPolls = 0;
+    Clock::time_point lastPublish{};
+    auto publish = [&] {
+        if (views && unpublished) {
+            views->publish(fleet);
+            lastPublish = Clock::now();
+        }
+        unpublished = 0;
+    };
+    for (;;) {
+        if (std::size_t drained = drainAll()) {
+            unpublished += drained;
+            if (unpublished >= publishInterval) publish();
+            emptyPolls = 0;
+            continue;
+        }
+        if (unpublished && Clock::now() - lastPublish >= publishGap) publish();
+        if (stopping.load(std::memory_order_acquire)) {
+            // Readings pushed before stop() are visible now; take them and exit.
+            while (std::size_t drained = drainAll()) unpublished += drained;
+            publish();
+            return;
+        }
+        if (++emptyPolls < SPIN_POLLS) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::optional<Clock::time_point> publishDue;
+        if (views) {
+            views->reclaim();
+            if (unpublished) publishDue = lastPublish + publishGap;
+        }
+        sleep(publishDue);
+        emptyPolls = 0;
+    }
+}
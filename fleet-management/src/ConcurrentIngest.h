@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "FleetManager.h"
+#include "FleetReadView.h"
+#include "SpscQueue.h"
+
+// One reading pushed by a producer thread.
+struct TelemetryReading {
+    int id;
+    double speed;
+    double temperature;
+    double fuel;
+};
+
+// Concurrent ingestion path for many producer threads (e.g. one per gateway
+// connection). Every producer owns a lock-free SPSC queue; a single applier
+// thread drains the queues round-robin and upserts the readings into the fleet,
+// so FleetManager itself stays single-threaded. When the queues stay empty the
+// applier sleeps until the next push instead of spinning. While the applier runs, nothing
+// else may touch the fleet; stop() hands it back. Readers that need the fleet
+// meanwhile use the views the applier publishes (see publishViews).
+class ConcurrentIngest {
+public:
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 4096;
+    static constexpr std::size_t DEFAULT_PUBLISH_INTERVAL = 1 << 16;
+    static constexpr std::chrono::milliseconds DEFAULT_PUBLISH_GAP{20};
+
+    // Handle through which one thread feeds its own queue. Copyable, but at most
+    // one thread may push through a given producer's queue at a time.
+    class Producer {
+    private:
+        ConcurrentIngest* owner;
+        SpscQueue<TelemetryReading>* queue;
+
+    public:
+        Producer(ConcurrentIngest& owner, SpscQueue<TelemetryReading>& queue) : owner(&owner), queue(&queue) {}
+        bool tryPush(const TelemetryReading& reading) {
+            if (!queue->tryPush(reading)) return false;
+            owner->pushed();
+            return true;
+        }
+        void push(const TelemetryReading& reading);  // Yields while the queue is full
+    };
+
+private:
+    FleetManager& fleet;
+    std::vector<std::unique_ptr<SpscQueue<TelemetryReading>>> queues;
+    std::thread applier;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> sleeping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<std::size_t> readingsApplied{0};
+    FleetViewStore* views{nullptr};
+    std::size_t publishInterval{DEFAULT_PUBLISH_INTERVAL};
+    std::chrono::steady_clock::duration publishGap{DEFAULT_PUBLISH_GAP};
+
+    void applyLoop();
+    std::size_t drainAll();
+    bool queuesEmpty() const;
+    void sleep(std::optional<std::chrono::steady_clock::time_point> until);
+    void wake();
+
+    // Called after every successful push. The fence pairs with the one in sleep(): either
+    // the applier sees the reading when it re-checks the queues, or this sees it asleep.
+    void pushed() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed)) wake();
+    }
+
+public:
+    ConcurrentIngest(FleetManager& fleet, std::size_t producers,
+                     std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+    ~ConcurrentIngest();
+
+    ConcurrentIngest(const ConcurrentIngest&) = delete;
+    ConcurrentIngest& operator=(const ConcurrentIngest&) = delete;
+
+    std::size_t producers() const { return queues.size(); }
+    Producer producer(std::size_t index) { return Producer(*this, *queues.at(index)); }
+
+    void publishViews(FleetViewStore& views, std::size_t everyReadings = DEFAULT_PUBLISH_INTERVAL,
+                      std::chrono::milliseconds minGap = DEFAULT_PUBLISH_GAP);
+    void start();
+    void stop();  // Applies everything pushed before the call, then joins the applier
+    bool running() const { return applier.joinable(); }
+    bool asleep() const { return sleeping.load(std::memory_order_relaxed); }  // Applier waiting for a push
+    std::size_t applied() const { return readingsApplied.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,375 @@
+#include "CsvLoader.h"
+#include "MappedFile.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+    inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    // Parses one numeric field ending at the next `delim` (or `last`) and advances `first` past it.
+    template<typename T>
+    bool parseField(const char*& first, const char* last, char delim, T& value) {
+        const char* fieldEnd = static_cast<const char*>(std::memchr(first, delim, last - first));
+        if (fieldEnd == nullptr) {
+            if (delim != '\n') return false;
+            fieldEnd = last;
+        }
+
+        const char* begin = first;
+        const char* end = fieldEnd;
+        while (begin != end && isBlank(*begin)) ++begin;
+        while (end != begin && isBlank(end[-1])) --end;
+        if (begin != end && *begin == '+') ++begin;
+
+        auto result = std::from_chars(begin, end, value);
+        if (result.ec != std::errc() || result.ptr != end) return false;
+
+        first = fieldEnd == last ? last : fieldEnd + 1;
+        return true;
+    }
+
+    // Returns the end of the line starting at `first`, excluding the '\n'.
+    inline const char* findLineEnd(const char* first, const char* last) {
+        const char* nl = static_cast<const char*>(std::memchr(first, '\n', last - first));
+        return nl ? nl : last;
+    }
+
+    inline bool isBlankLine(const char* first, const char* last) {
+        while (first != last && isBlank(*first)) ++first;
+        return first == last;
+    }
+
+    inline const char* nextLine(const char* first, const char* last) {
+        const char* lineEnd = findLineEnd(first, last);
+        return lineEnd == last ? last : lineEnd + 1;
+    }
+
+    std::size_t countLines(const char* first, const char* last) {
+        std::size_t lines = 0;
+        for (; first != last; ++lines) first = nextLine(first, last);
+        return lines;
+    }
+
+    // Parses every row in [first, last), handing valid records to `onRow` and the
+    // bounds of malformed, non-blank lines to `onError`.
+    template<typename OnRow, typename OnError>
+    void forEachRow(const char* first, const char* last, OnRow onRow, OnError onError) {
+        VehicleRecord record;
+        while (first != last) {
+            const char* lineEnd = findLineEnd(first, last);
+            if (parseVehicleRecord(first, lineEnd, record)) {
+                onRow(record);
+            }
+            else if (!isBlankLine(first, lineEnd)) {
+                onError(first, lineEnd);
+            }
+            first = lineEnd == last ? last : lineEnd + 1;
+        }
+    }
+
+    void reportBadLine(const char* first, const char* last) {
+        instrumentation::add(instrumentation::Counter::ParseFailures);
+        std::cerr << "Error parsing line: ";
+        std::cerr.write(first, last - first) << '\n';
+    }
+
+    // Below this many bytes per worker the thread start-up cost outweighs the parse.
+    constexpr std::size_t MIN_PARALLEL_CHUNK = 1 << 20;
+
+    struct Shard {
+        std::vector<Vehicle> vehicles;
+        std::vector<std::pair<const char*, const char*>> badLines;
+    };
+
+    // Cuts [first, last) into up to `threads` ranges of at least MIN_PARALLEL_CHUNK bytes, each
+    // boundary moved forward to just past the next '\n' so no row is split. Returns range bounds.
+    std::vector<const char*> splitRows(const char* first, const char* last, unsigned threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        std::size_t bytes = static_cast<std::size_t>(last - first);
+        std::size_t workers = std::max<std::size_t>(1, std::min<std::size_t>(threads, bytes / MIN_PARALLEL_CHUNK));
+
+        std::vector<const char*> bounds{first};
+        for (std::size_t i = 1; i < workers; ++i) {
+            const char* cut = std::max(bounds.back(), first + bytes * i / workers);
+            bounds.push_back(cut == first ? first : nextLine(cut - 1, last));
+        }
+        bounds.push_back(last);
+        return bounds;
+    }
+
+    // Runs task(i) for every range i, ranges 1.. on worker threads and range 0 on the caller.
+    template<typename Task>
+    auto forEachRange(std::size_t ranges, Task task) {
+        using Result = decltype(task(std::size_t{0}));
+        std::vector<std::future<Result>> pending;
+        for (std::size_t i = 1; i < ranges; ++i) pending.push_back(std::async(std::launch::async, task, i));
+        std::vector<Result> results;
+        results.push_back(task(0));
+        for (auto& result : pending) results.push_back(result.get());
+        return results;
+    }
+
+    // Destination of one range of the bulk columnar loader.
+    struct ColumnSlice {
+        int* ids;
+        double* speeds;
+        double* temperatures;
+        double* fuels;
+        std::size_t rows{0};
+        std::vector<std::pair<const char*, const char*>> badLines;
+    };
+
+    Shard parseShard(const char* first, const char* last) {
+        Shard shard;
+        shard.vehicles.reserve(countLines(first, last));
+        forEachRow(first, last,
+            [&shard](const VehicleRecord& r) {
+                shard.vehicles.emplace_back(r.id, r.speed, r.temperature, r.fuel);
+            },
+            [&shard](const char* lineBegin, const char* lineEnd) {
+                shard.badLines.emplace_back(lineBegin, lineEnd);
+            });
+        return shard;
+    }
+}
+
+/**
+ * @brief Parses one `id,speed,temperature,fuel` row without allocating.
+ *
+ * Fields are converted with std::from_chars directly from the source bytes. Surrounding
+ * spaces, tabs and a trailing '\r' are ignored; any other stray character makes the row invalid.
+ *
+ * @param first Pointer to the first character of the row.
+ * @param last Pointer one past the last character of the row (not including '\n').
+ * @param record Receives the parsed values; left partially written on failure.
+ * @return true if all four fields were parsed, false otherwise.
+ */
+bool parseVehicleRecord(const char* first, const char* last, VehicleRecord& record) {
+    return parseField(first, last, ',', record.id)
+        && parseField(first, last, ',', record.speed)
+        && parseField(first, last, ',', record.temperature)
+        && parseField(first, last, '\n', record.fuel);
+}
+
+/**
+ * @brief Loads vehicle data from a CSV file into a vector of Vehicle objects.
+ *
+ * This function reads vehicle information from the specified CSV file, parses each line,
+ * and constructs Vehicle objects which are appended to the provided vector. The CSV file
+ * is expected to have the following columns: ID, Speed, Temperature, Fuel. The first line
+ * (header) is skipped. If a line cannot be parsed, an error message is printed and the line is skipped.
+ *
+ * @param filename The path to the CSV file containing vehicle data.
+ * @param vehicles Reference to a vector where the loaded Vehicle objects will be stored.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+void loadVehicleData(const std::string& filename, std::vector<Vehicle>& vehicles) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+
+    std::string line;
+    std::size_t before = vehicles.size();
+    std::uint64_t bytes = 0;
+    std::uint64_t failures = 0;
+    // Skip header line if exists
+    if (std::getline(file, line)) bytes += line.size() + !file.eof();
+
+    while (std::getline(file, line)) {
+        bytes += line.size() + !file.eof();
+        std::istringstream ss(line);
+        std::string idStr, speedStr, tempStr, fuelStr;
+
+        std::getline(ss, idStr, ',');
+        std::getline(ss, speedStr, ',');
+        std::getline(ss, tempStr, ',');
+        std::getline(ss, fuelStr);
+
+        try {
+            int id = std::stoi(idStr);
+            double speed = std::stod(speedStr);
+            double temperature = std::stod(tempStr);
+            double fuel = std::stod(fuelStr);
+
+            vehicles.emplace_back(id, speed, temperature, fuel);
+            std::cout << "Loaded vehicle ID: " << id << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error parsing line: " << line << std::endl;
+            ++failures;
+            continue;
+        }
+    }
+
+    instrumentation::add(instrumentation::Counter::BytesRead, bytes);
+    instrumentation::add(instrumentation::Counter::RowsParsed, vehicles.size() - before);
+    instrumentation::add(instrumentation::Counter::ParseFailures, failures);
+}
+
+/**
+ * @brief Loads vehicle data from a CSV file by parsing the memory-mapped file in place.
+ *
+ * Same input format as loadVehicleData (header line skipped, rows of ID, Speed, Temperature, Fuel),
+ * but the file is mapped instead of streamed and every row is parsed straight from the mapped bytes
+ * with parseVehicleRecord. The destination is reserved once from a newline count, so the parse loop
+ * performs no heap allocation per row. Blank lines are skipped; malformed lines are reported on
+ * std::cerr and skipped. Unlike loadVehicleData, loaded rows are not echoed to std::cout.
+ *
+ * @param filename The path to the CSV file containing vehicle data.
+ * @param vehicles Reference to a vector where the loaded Vehicle objects will be appended.
+ *
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ */
+void loadVehicleDataMapped(const std::string& filename, std::vector<Vehicle>& vehicles) {
+    MappedFile file(filename);
+    const char* first = file.begin();
+    const char* last = file.end();
+    if (first == last) return;
+    instrumentation::add(instrumentation::Counter::BytesRead, file.size());
+
+    // Skip header line if exists
+    first = nextLine(first, last);
+
+    std::size_t before = vehicles.size();
+    vehicles.reserve(vehicles.size() + countLines(first, last));
+    forEachRow(first, last,
+        [&vehicles](const VehicleRecord& r) { vehicles.emplace_back(r.id, r.speed, r.temperature, r.fuel); },
+        reportBadLine);
+    instrumentation::add(instrumentation::Counter::RowsParsed, vehicles.size() - before);
+}
+
+/**
+ * @brief Loads vehicle data from a CSV file by parsing newline-aligned chunks on worker threads.
+ *
+ * The mapped file body (after the header line) is cut into one byte range per worker, each boundary
+ * moved forward to just past the next '\n' so no row is split. Every worker parses its range into
+ * its own shard; the shards are then appended to `vehicles` in range order, so the result is
+ * identical to loadVehicleDataMapped. Malformed lines are reported on std::cerr after all workers
+ * have finished, also in file order. Files too small to be worth splitting are parsed inline.
+ *
+ * @param filename The path to the CSV file containing vehicle data.
+ * @param vehicles Reference to a vector where the loaded Vehicle objects will be appended.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency().
+ *
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ */
+void loadVehicleDataParallel(const std::string& filename, std::vector<Vehicle>& vehicles, unsigned threads) {
+    MappedFile file(filename);
+    const char* first = file.begin();
+    const char* last = file.end();
+    if (first == last) return;
+    instrumentation::add(instrumentation::Counter::BytesRead, file.size());
+
+    // Skip header line if exists
+    first = nextLine(first, last);
+
+    std::vector<const char*> bounds = splitRows(first, last, threads);
+    std::vector<Shard> shards = forEachRange(bounds.size() - 1, [&bounds](std::size_t i) {
+        return parseShard(bounds[i], bounds[i + 1]);
+    });
+
+    std::size_t before = vehicles.size();
+    std::size_t total = before;
+    for (const auto& shard : shards) total += shard.vehicles.size();
+    // An empty output takes the first shard's buffer over instead of copying it; with a single
+    // shard, as for small files, no row is copied at all.
+    std::size_t merged = 0;
+    if (vehicles.empty()) {
+        vehicles = std::move(shards[0].vehicles);
+        merged = 1;
+    }
+    vehicles.reserve(total);
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        Shard& shard = shards[i];
+        if (i >= merged) vehicles.insert(vehicles.end(), shard.vehicles.begin(), shard.vehicles.end());
+        for (const auto& line : shard.badLines) reportBadLine(line.first, line.second);
+        std::vector<Vehicle>().swap(shard.vehicles);
+    }
+    instrumentation::add(instrumentation::Counter::RowsParsed, vehicles.size() - before);
+}
+
+/**
+ * @brief Loads a CSV file straight into columnar storage with a single allocation per column.
+ *
+ * The mapped file body is split into newline-aligned ranges as in loadVehicleDataParallel. A first
+ * parallel pass counts the lines of every range; their prefix sums size the four columns once and
+ * give each range its own slice. The second pass parses each range directly into its slice, so no
+ * row is stored twice and no container grows while parsing. Slices left short by blank or malformed
+ * lines are then closed up in order. The columns are moved into the returned FleetColumns, so peak
+ * memory is the fleet itself plus the line-count slack. Output and error reporting match
+ * loadVehicleDataMapped.
+ *
+ * @param filename The path to the CSV file containing vehicle data.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency(), 1 parses inline.
+ * @return The loaded fleet in file order.
+ *
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ */
+FleetColumns loadFleetColumns(const std::string& filename, unsigned threads) {
+    MappedFile file(filename);
+    const char* first = file.begin();
+    const char* last = file.end();
+    if (first == last) return FleetColumns();
+    instrumentation::add(instrumentation::Counter::BytesRead, file.size());
+
+    // Skip header line if exists
+    first = nextLine(first, last);
+
+    std::vector<const char*> bounds = splitRows(first, last, threads);
+    const std::size_t ranges = bounds.size() - 1;
+    std::vector<std::size_t> lines = forEachRange(ranges, [&bounds](std::size_t i) {
+        return countLines(bounds[i], bounds[i + 1]);
+    });
+    std::vector<std::size_t> offsets{0};
+    for (std::size_t count : lines) offsets.push_back(offsets.back() + count);
+
+    std::vector<int> ids(offsets.back());
+    std::vector<double> speeds(offsets.back()), temperatures(offsets.back()), fuels(offsets.back());
+    std::vector<ColumnSlice> slices = forEachRange(ranges, [&](std::size_t i) {
+        const std::size_t offset = offsets[i];
+        ColumnSlice slice{ids.data() + offset, speeds.data() + offset, temperatures.data() + offset,
+                          fuels.data() + offset, 0, {}};
+        forEachRow(bounds[i], bounds[i + 1],
+            [&slice](const VehicleRecord& r) {
+                slice.ids[slice.rows] = r.id;
+                slice.speeds[slice.rows] = r.speed;
+                slice.temperatures[slice.rows] = r.temperature;
+                slice.fuels[slice.rows] = r.fuel;
+                ++slice.rows;
+            },
+            [&slice](const char* lineBegin, const char* lineEnd) {
+                slice.badLines.emplace_back(lineBegin, lineEnd);
+            });
+        return slice;
+    });
+
+    std::size_t rows = 0;
+    for (std::size_t i = 0; i < ranges; ++i) {
+        const ColumnSlice& slice = slices[i];
+        if (rows != offsets[i]) {
+            std::move(slice.ids, slice.ids + slice.rows, ids.begin() + rows);
+            std::move(slice.speeds, slice.speeds + slice.rows, speeds.begin() + rows);
+            std::move(slice.temperatures, slice.temperatures + slice.rows, temperatures.begin() + rows);
+            std::move(slice.fuels, slice.fuels + slice.rows, fuels.begin() + rows);
+        }
+        rows += slice.rows;
+        for (const auto& line : slice.badLines) reportBadLine(line.first, line.second);
+    }
+    ids.resize(rows);
+    speeds.resize(rows);
+    temperatures.resize(rows);
+    fuels.resize(rows);
+    instrumentation::add(instrumentation::Counter::RowsParsed, rows);
+    return FleetColumns(std::move(ids), std::move(speeds), std::move(temperatures), std::move(fuels));
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Vehicle.h"
+#include "FleetColumns.h"
+
+// One parsed `id,speed,temperature,fuel` row.
+struct VehicleRecord {
+    int id;
+    double speed;
+    double temperature;
+    double fuel;
+};
+
+// Parses a single CSV row in [first, last) without allocating. Returns false if
+// any of the four fields is missing or malformed.
+bool parseVehicleRecord(const char* first, const char* last, VehicleRecord& record);
+
+// Reference loader: std::getline + std::istringstream per row.
+void loadVehicleData(const std::string& filename, std::vector<Vehicle>& vehicles);
+
+// Zero-copy loader: maps the file and parses rows straight from the mapped bytes.
+void loadVehicleDataMapped(const std::string& filename, std::vector<Vehicle>& vehicles);
+
+// Bulk columnar loader: sizes the columns once from a line count, parses every
+// chunk straight into its slice on `threads` workers (0 = hardware concurrency)
+// and returns them without an intermediate Vehicle array.
+FleetColumns loadFleetColumns(const std::string& filename, unsigned threads = 0);
+
+// Parallel loader: parses newline-aligned chunks of the mapped file on `threads`
+// workers (0 = hardware concurrency) and merges them in original row order.
+void loadVehicleDataParallel(const std::string& filename, std::vector<Vehicle>& vehicles, unsigned threads = 0);
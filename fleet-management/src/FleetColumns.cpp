@@ -0,0 +1,162 @@
+#include "FleetColumns.h"
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Builds columnar storage from an array-of-structs fleet.
+ *
+ * Each Vehicle is split across the id, speed, temperature and fuel columns; slot i in every
+ * column refers to fleet[i]. All columns are sized once up front.
+ *
+ * @param fleet The vehicles to transpose into columns.
+ */
+FleetColumns::FleetColumns(const std::vector<Vehicle>& fleet) {
+    reserve(fleet.size());
+    for (const auto& vehicle : fleet) {
+        append(vehicle);
+    }
+}
+
+/**
+ * @brief Takes ownership of four already filled columns without copying them.
+ *
+ * Bulk loaders fill the column vectors in place and hand them over, so the fleet never exists
+ * twice in memory.
+ *
+ * @param ids Id column.
+ * @param speeds Speed column.
+ * @param temperatures Temperature column.
+ * @param fuels Fuel column.
+ *
+ * @throws std::invalid_argument If the columns differ in length.
+ */
+FleetColumns::FleetColumns(std::vector<int>&& ids, std::vector<double>&& speeds,
+                           std::vector<double>&& temperatures, std::vector<double>&& fuels)
+    : idColumn(std::move(ids)), speedColumn(std::move(speeds)), temperatureColumn(std::move(temperatures)),
+      fuelColumn(std::move(fuels)) {
+    if (speedColumn.size() != idColumn.size() || temperatureColumn.size() != idColumn.size()
+        || fuelColumn.size() != idColumn.size()) {
+        throw std::invalid_argument("Fleet columns differ in length");
+    }
+}
+
+void FleetColumns::reserve(std::size_t capacity) {
+    idColumn.reserve(capacity);
+    speedColumn.reserve(capacity);
+    temperatureColumn.reserve(capacity);
+    fuelColumn.reserve(capacity);
+}
+
+/**
+ * @brief Replaces the contents of every column with `count` values copied from raw arrays.
+ *
+ * Each column is filled with one contiguous copy, which is how bulk sources such as mapped
+ * binary snapshots are loaded without per-vehicle work.
+ *
+ * @param ids Source id array.
+ * @param speeds Source speed array.
+ * @param temperatures Source temperature array.
+ * @param fuels Source fuel array.
+ * @param count Number of vehicles in each source array.
+ */
+void FleetColumns::assign(const int* ids, const double* speeds, const double* temperatures,
+                          const double* fuels, std::size_t count) {
+    idColumn.assign(ids, ids + count);
+    speedColumn.assign(speeds, speeds + count);
+    temperatureColumn.assign(temperatures, temperatures + count);
+    fuelColumn.assign(fuels, fuels + count);
+}
+
+/**
+ * @brief Appends one vehicle's readings as a new slot at the end of every column.
+ *
+ * @param id Unique identifier for the vehicle.
+ * @param speed Current speed of the vehicle.
+ * @param temperature Current temperature reading of the vehicle.
+ * @param fuel Current fuel level of the vehicle.
+ */
+void FleetColumns::append(int id, double speed, double temperature, double fuel) {
+    idColumn.push_back(id);
+    speedColumn.push_back(speed);
+    temperatureColumn.push_back(temperature);
+    fuelColumn.push_back(fuel);
+}
+
+void FleetColumns::append(const Vehicle& vehicle) {
+    append(vehicle.getId(), vehicle.getSpeed(), vehicle.getTemperature(), vehicle.getFuel());
+}
+
+void FleetColumns::clear() {
+    idColumn.clear();
+    speedColumn.clear();
+    temperatureColumn.clear();
+    fuelColumn.clear();
+}
+
+/**
+ * @brief Overwrites the readings stored at a slot; the id is left unchanged.
+ *
+ * @param slot Index into the columns; must be less than size().
+ * @param speed New speed of the vehicle.
+ * @param temperature New temperature reading of the vehicle.
+ * @param fuel New fuel level of the vehicle.
+ */
+void FleetColumns::setReading(std::size_t slot, double speed, double temperature, double fuel) {
+    speedColumn[slot] = speed;
+    temperatureColumn[slot] = temperature;
+    fuelColumn[slot] = fuel;
+}
+
+/**
+ * @brief Removes a slot in O(1) by moving the last slot into its place.
+ *
+ * The order of the remaining vehicles changes: whatever was in the last slot now lives at `slot`.
+ *
+ * @param slot Index into the columns; must be less than size().
+ */
+void FleetColumns::swapRemove(std::size_t slot) {
+    std::size_t last = size() - 1;
+    idColumn[slot] = idColumn[last];
+    speedColumn[slot] = speedColumn[last];
+    temperatureColumn[slot] = temperatureColumn[last];
+    fuelColumn[slot] = fuelColumn[last];
+    idColumn.pop_back();
+    speedColumn.pop_back();
+    temperatureColumn.pop_back();
+    fuelColumn.pop_back();
+}
+
+/**
+ * @brief Copies the id and readings of one slot over another.
+ *
+ * @param from Slot to copy; must be less than size().
+ * @param to Slot to overwrite; must be less than size().
+ */
+void FleetColumns::moveSlot(std::size_t from, std::size_t to) {
+    idColumn[to] = idColumn[from];
+    speedColumn[to] = speedColumn[from];
+    temperatureColumn[to] = temperatureColumn[from];
+    fuelColumn[to] = fuelColumn[from];
+}
+
+/**
+ * @brief Drops every slot from `count` on.
+ *
+ * @param count Number of slots to keep; must not exceed size().
+ */
+void FleetColumns::truncate(std::size_t count) {
+    idColumn.resize(count);
+    speedColumn.resize(count);
+    temperatureColumn.resize(count);
+    fuelColumn.resize(count);
+}
+
+/**
+ * @brief Reassembles the Vehicle stored at a slot.
+ *
+ * @param slot Index into the columns; must be less than size().
+ * @return A Vehicle holding the id and readings stored at that slot.
+ */
+Vehicle FleetColumns::vehicle(std::size_t slot) const {
+    return Vehicle(idColumn[slot], speedColumn[slot], temperatureColumn[slot], fuelColumn[slot]);
+}
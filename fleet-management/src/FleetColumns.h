@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Vehicle.h"
+
+// The per-vehicle readings, in column order.
+enum class Metric { Speed, Temperature, Fuel };
+
+// Structure-of-arrays fleet storage: one contiguous array per vehicle field,
+// all indexed by the same slot. Scans over a single metric touch only that
+// metric's array.
+class FleetColumns {
+private:
+    std::vector<int> idColumn;
+    std::vector<double> speedColumn;
+    std::vector<double> temperatureColumn;
+    std::vector<double> fuelColumn;
+
+public:
+    FleetColumns() = default;
+    explicit FleetColumns(const std::vector<Vehicle>& fleet);
+    FleetColumns(std::vector<int>&& ids, std::vector<double>&& speeds, std::vector<double>&& temperatures,
+                 std::vector<double>&& fuels);
+
+    void reserve(std::size_t capacity);
+    void assign(const int* ids, const double* speeds, const double* temperatures, const double* fuels,
+                std::size_t count);
+    void append(int id, double speed, double temperature, double fuel);
+    void append(const Vehicle& vehicle);
+    void clear();
+    void setReading(std::size_t slot, double speed, double temperature, double fuel);
+    void swapRemove(std::size_t slot);
+    void moveSlot(std::size_t from, std::size_t to);  // Overwrites `to`, id included
+    void truncate(std::size_t count);
+
+    std::size_t size() const { return idColumn.size(); }
+    bool empty() const { return idColumn.empty(); }
+
+    const int* ids() const { return idColumn.data(); }
+    const double* speeds() const { return speedColumn.data(); }
+    const double* temperatures() const { return temperatureColumn.data(); }
+    const double* fuels() const { return fuelColumn.data(); }
+
+    Vehicle vehicle(std::size_t slot) const;
+};
@@ -1,92 +1,372 @@
 #include "FleetManager.h"
+#include "ParallelReduce.h"
+#include "AlertEngine.h"
+#include "Instrumentation.h"
 #include <iostream>
-#include <numeric>
 #include <algorithm>
+#include <utility>
 
 /**
- * @brief Anonymous namespace containing utility constants and functions for FleetManager.
+ * @brief Builds the fleet store and id index and seeds the running statistics with one pass over it.
  *
- * Defines critical temperature and low fuel threshold constants used for vehicle monitoring.
- * Provides a template function to compute the average of a property across a collection of vehicles.
+ * Each id occupies one slot. If an id repeats, later rows are treated like readings for the vehicle
+ * already added: they replace its readings and are dropped, so the fleet keeps first-seen order.
+ * Each dropped row is reported on std::cerr, since it changes what the input would otherwise show.
+ *
+ * @param fleet The vehicles to manage.
+ */
+FleetManager::FleetManager(const std::vector<Vehicle>& fleet) : columns(fleet) {
+    indexColumns();
+}
+
+/**
+ * @brief Builds the fleet from a vector the caller no longer needs.
+ *
+ * The vehicles are transposed into the columns exactly as by the copying constructor, but the source
+ * buffer is released as soon as that is done instead of living on in the caller, so the fleet is
+ * held once rather than twice for the rest of the caller's scope. The rows themselves cannot be moved:
+ * the fleet is stored column by column, so every field is still copied once. To build a fleet with no
+ * copy at all, load it as columns (loadFleetColumns, SnapshotView::toColumns) and hand them to
+ * FleetManager(FleetColumns&&).
+ *
+ * @param fleet The vehicles to manage; left empty.
+ */
+FleetManager::FleetManager(std::vector<Vehicle>&& fleet) : columns(fleet) {
+    std::vector<Vehicle>().swap(fleet);
+    indexColumns();
+}
+
+/**
+ * @brief Takes ownership of an already columnar fleet, e.g. one loaded from a binary snapshot.
+ *
+ * @param fleet The fleet store to adopt; it is moved from, not copied.
+ */
+FleetManager::FleetManager(FleetColumns&& fleet) : columns(std::move(fleet)) {
+    indexColumns();
+}
+
+void FleetManager::indexColumns() {
+    slotsById.clear();
+    slotsById.reserve(columns.size());
+    std::size_t kept = 0;
+    for (std::size_t slot = 0; slot < columns.size(); ++slot) {
+        if (slotsById.insert(columns.ids()[slot], kept)) {
+            if (kept != slot) columns.moveSlot(slot, kept);
+            ++kept;
+        } else {
+            std::cerr << "Duplicate vehicle ID " << columns.ids()[slot]
+                      << ": row replaces the vehicle's earlier readings\n";
+            columns.setReading(slotsById.find(columns.ids()[slot]), columns.speeds()[slot],
+                               columns.temperatures()[slot], columns.fuels()[slot]);
+        }
+    }
+    if (kept != columns.size()) columns.truncate(kept);
+    moments.reset(computeFleetStats(columns));
+}
+
+/**
+ * @brief Adds a vehicle to the fleet and folds its readings into the running statistics in O(1).
+ *
+ * If a vehicle with the same id is already in the fleet, its readings are replaced instead, as by
+ * updateReading; ids stay unique.
+ *
+ * @param vehicle The vehicle to add.
+ */
+void FleetManager::addVehicle(const Vehicle& vehicle) {
+    appendVehicle(vehicle.getId(), vehicle.getSpeed(), vehicle.getTemperature(), vehicle.getFuel());
+}
+
+/**
+ * @brief Adds a temporary vehicle; its fields go straight into the columns, as for the const overload.
+ *
+ * @param vehicle The vehicle to add.
+ */
+void FleetManager::addVehicle(Vehicle&& vehicle) {
+    addVehicle(static_cast<const Vehicle&>(vehicle));
+}
+
+/**
+ * @brief Appends one vehicle's fields to the columns, id index and running statistics.
+ *
+ * Shared by addVehicle and emplaceVehicle; no Vehicle object is constructed on this path. A known id
+ * updates that vehicle's slot rather than adding a second one.
+ */
+void FleetManager::appendVehicle(int id, double speed, double temperature, double fuel) {
+    if (!slotsById.insert(id, columns.size())) {
+        updateReading(id, speed, temperature, fuel);
+        return;
+    }
+    columns.append(id, speed, temperature, fuel);
+    moments.add(speed, temperature, fuel);
+    if (readingHistory) {
+        readingHistory->resize(columns.size());
+        readingHistory->append(columns.size() - 1, speed, temperature, fuel);
+    }
+}
+
+/**
+ * @brief Grows the columns and id index to hold `capacity` vehicles without further reallocation.
+ *
+ * @param capacity Total number of vehicles the fleet is expected to hold.
+ */
+void FleetManager::reserve(std::size_t capacity) {
+    columns.reserve(capacity);
+    slotsById.reserve(capacity);
+}
+
+/**
+ * @brief Removes the vehicle with the given id and takes its readings out of the running statistics.
+ *
+ * The removed slot is filled by the last vehicle, so fleet order is not preserved.
+ *
+ * @param id Identifier of the vehicle to remove.
+ * @return true if a vehicle was removed, false if no vehicle has that id.
+ */
+bool FleetManager::removeVehicle(int id) {
+    std::size_t slot = slotsById.find(id);
+    if (slot == VehicleIndex::NPOS) return false;
+
+    moments.remove(columns.speeds()[slot], columns.temperatures()[slot], columns.fuels()[slot]);
+    slotsById.erase(id);
+    std::size_t last = columns.size() - 1;
+    int movedId = columns.ids()[last];
+    columns.swapRemove(slot);
+    if (readingHistory) readingHistory->swapRemove(slot);
+    alertStates.swapRemove(slot, last);
+    if (slot != last && slotsById.find(movedId) == last) {
+        slotsById.assign(movedId, slot);
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the readings of the vehicle with the given id, adjusting the running statistics in O(1).
+ *
+ * The vehicle is located through the open-addressing id index and its slot is overwritten in place,
+ * so applying a reading costs one hash probe and three column stores regardless of fleet size.
+ *
+ * @param id Identifier of the vehicle to update.
+ * @param speed New speed reading.
+ * @param temperature New temperature reading.
+ * @param fuel New fuel reading.
+ * @return true if the vehicle exists and was updated, false otherwise.
+ */
+bool FleetManager::updateReading(int id, double speed, double temperature, double fuel) {
+    std::size_t slot = slotsById.find(id);
+    if (slot == VehicleIndex::NPOS) return false;
+
+    moments.speed.replace(columns.speeds()[slot], speed);
+    moments.temperature.replace(columns.temperatures()[slot], temperature);
+    moments.fuel.replace(columns.fuels()[slot], fuel);
+    columns.setReading(slot, speed, temperature, fuel);
+    if (readingHistory) readingHistory->append(slot, speed, temperature, fuel);
+    return true;
+}
+
+/**
+ * @brief Applies a reading to the vehicle with the given id, adding the vehicle if it is new.
+ *
+ * @param id Identifier of the vehicle.
+ * @param speed New speed reading.
+ * @param temperature New temperature reading.
+ * @param fuel New fuel reading.
  */
+void FleetManager::upsertReading(int id, double speed, double temperature, double fuel) {
+    if (!updateReading(id, speed, temperature, fuel)) {
+        appendVehicle(id, speed, temperature, fuel);
+    }
+}
 
 /**
- * @brief Computes the average value of a specific property for a collection of vehicles.
+ * @brief Starts keeping a per-vehicle history of readings.
  *
- * This template function iterates over the provided vector of Vehicle objects and applies
- * the specified member function getter to each vehicle to retrieve the property value.
- * It then calculates and returns the average of these values.
+ * Every vehicle's current reading becomes its first sample; from then on each added vehicle and each
+ * applied reading appends one sample, and removed vehicles take their history with them. Calling this
+ * again discards the previous history.
  *
- * @tparam Getter Type of member function pointer used to access the property from Vehicle.
- * @param vehicles Vector of Vehicle objects to compute the average from.
- * @param getter Member function pointer to retrieve the desired property from each Vehicle.
- * @return The average value of the specified property across all vehicles, or 0.0 if the vector is empty.
+ * @param capacity Samples kept per vehicle (see TelemetryHistory).
+ * @param extremaWindow Number of recent samples covered by the history's min and max.
  */
-namespace {
-    constexpr double CRITICAL_TEMP = 110.0;
-    constexpr double LOW_FUEL_THRESHOLD = 15.0;
-    
-    template<typename Getter>
-    double computeAverage(const std::vector<Vehicle>& vehicles, Getter getter) {
-        if (vehicles.empty()) return 0.0;
-        double total = std::accumulate(vehicles.begin(), vehicles.end(), 0.0,
-            [getter](double sum, const Vehicle& v) { return sum + (v.*getter)(); });
-        return total / vehicles.size();
+void FleetManager::enableHistory(std::size_t capacity, std::size_t extremaWindow) {
+    readingHistory.emplace(capacity, extremaWindow);
+    readingHistory->resize(columns.size());
+    for (std::size_t slot = 0; slot < columns.size(); ++slot) {
+        readingHistory->append(slot, columns.speeds()[slot], columns.temperatures()[slot], columns.fuels()[slot]);
     }
 }
 
-FleetManager::FleetManager(const std::vector<Vehicle>& fleet) : vehicles(fleet) {}
+/**
+ * @brief Configures the parallel reduction used by computeAverages.
+ *
+ * Ignored while a task pool is set (see setTaskPool), except for the serial threshold, which
+ * applies to the pool as well.
+ *
+ * @param threads Number of worker threads; 0 uses every hardware thread, 1 forces a serial scan.
+ * @param serialThreshold Fleets with fewer vehicles than this are always reduced serially,
+ *        since thread start-up would cost more than the scan itself.
+ */
+void FleetManager::setParallelism(unsigned threads, std::size_t serialThreshold) {
+    reductionThreads = threads;
+    parallelThreshold = serialThreshold;
+}
 
 /**
  * @brief Computes and updates the average speed, temperature, and fuel level for all vehicles in the fleet.
  *
- * This function iterates over the collection of vehicles and calculates the average values for speed,
- * temperature, and fuel by invoking the computeAverage utility with the appropriate member function pointers.
- * The computed averages are stored in the corresponding member variables: avgSpeed, avgTemp, and avgFuel.
+ * This function sums the speed, temperature and fuel columns and divides by the fleet size. Sums are
+ * computed block-wise with the vectorized simd::sum kernel and combined with Kahan summation; fleets
+ * at or above the configured threshold are partitioned across worker threads (see setParallelism),
+ * or into cache-sized chunks on the task pool if one is set (see setTaskPool).
  *
- * @note This method assumes that the vehicles container is properly populated and that the Vehicle class
- * provides the getSpeed, getTemperature, and getFuel member functions.
+ * The averages are otherwise kept current incrementally by addVehicle, removeVehicle and
+ * updateReading; this full rescan replaces the running means, discarding any rounding drift
+ * accumulated by long sequences of incremental updates.
  *
  * @return void This function does not return a value; it updates the FleetManager's average statistics.
  */
 void FleetManager::computeAverages() {
-    avgSpeed = computeAverage(vehicles, &Vehicle::getSpeed);
-    avgTemp = computeAverage(vehicles, &Vehicle::getTemperature);
-    avgFuel = computeAverage(vehicles, &Vehicle::getFuel);
+    instrumentation::ScopedTimer timer(instrumentation::Stage::ComputeAverages);
+    if (columns.empty()) {
+        moments = RunningFleetMoments();
+        return;
+    }
+    ColumnSums sums = usePool() ? sumColumns(columns, *taskPool)
+                                : sumColumns(columns, reductionThreads, parallelThreshold);
+    moments.speed.mean = sums.speed / columns.size();
+    moments.temperature.mean = sums.temperature / columns.size();
+    moments.fuel.mean = sums.fuel / columns.size();
 }
 
-double FleetManager::averageSpeed() const { return avgSpeed; }
+/**
+ * @brief Computes sum, min, max, count and variance of every metric in one pass over the fleet.
+ *
+ * Unlike computeAverages, this does not update the cached averages; it is intended for callers,
+ * such as dashboards, that need the full distribution summary at the cost of a single memory pass.
+ *
+ * @return The FleetStats for all vehicles; counts are zero for an empty fleet.
+ */
+FleetStats FleetManager::statistics() const {
+    return usePool() ? computeFleetStats(columns, *taskPool) : computeFleetStats(columns);
+}
+
+/**
+ * @brief Builds a log-linear histogram of every metric, from which any percentile can be read.
+ *
+ * Averages hide the tail of the distribution; p95 or p99 temperature shows how hot the hottest
+ * vehicles run. The histograms take one pass over the fleet and a fixed amount of memory however
+ * large it is, and large fleets are split across the threads configured with setParallelism.
+ *
+ * @return Speed, temperature and fuel histograms; quantile() of an empty fleet's histograms is NaN.
+ */
+FleetHistograms FleetManager::histograms() const {
+    if (usePool()) return parallelFleetHistograms(columns, *taskPool);
+    return parallelFleetHistograms(columns, reductionThreads, parallelThreshold);
+}
+
+double FleetManager::averageSpeed() const { return moments.speed.mean; }
 /**
  * @brief Calculates and returns the average temperature of the fleet.
  *
  * This function provides the average temperature value, which is maintained
- * internally by the FleetManager class. It can be used to monitor and analyze
+ * incrementally by the FleetManager class as vehicles are added, removed or
+ * updated, so it never requires a rescan of the fleet. It can be used to monitor and analyze
  * the overall temperature status of the fleet vehicles.
  *
  * @return The current average temperature of all vehicles managed by the fleet.
  */
-double FleetManager::averageTemperature() const { return avgTemp; }
-double FleetManager::averageFuel() const { return avgFuel; }
+double FleetManager::averageTemperature() const { return moments.temperature.mean; }
+double FleetManager::averageFuel() const { return moments.fuel.mean; }
+
+/**
+ * @brief Evaluates the alert rules for every vehicle without printing anything.
+ *
+ * @return Overheating and low fuel bitmasks indexed by fleet slot.
+ */
+AlertMasks FleetManager::evaluateAlerts() const {
+    return usePool() ? ::evaluateAlerts(columns, *taskPool) : ::evaluateAlerts(columns);
+}
+
+/**
+ * @brief Evaluates a configured rule set for every vehicle without printing anything.
+ *
+ * The fleet's current readings then become the rules' baseline, exactly as in checkAlerts(rules),
+ * so callers that format the result themselves see the same delta (rise/drop) matches.
+ *
+ * @param rules The rule engine to evaluate; its baseline is updated.
+ * @return One bitmask per rule, indexed by fleet slot.
+ */
+RuleMasks FleetManager::evaluateAlerts(AlertRuleEngine& rules) const {
+    RuleMasks masks = rules.evaluate(columns);
+    rules.updateBaseline(columns);
+    return masks;
+}
 
 /**
  * @brief Checks all vehicles in the fleet for critical alerts such as overheating and low fuel.
  *
- * Iterates through the list of vehicles managed by the FleetManager and prints alert messages
- * to the standard output if any vehicle exceeds the critical temperature threshold or falls
- * below the low fuel threshold.
+ * Evaluates the overheating and low fuel rules into bitmasks over the whole fleet first, then
+ * formats only the flagged vehicles into a single pre-sized buffer and writes it to standard
+ * output in one call, so scanning cost is independent of terminal I/O. Messages appear in fleet
+ * order, overheating before low fuel per vehicle.
  *
  * @return void This function does not return a value; alerts are output to the console.
  */
 void FleetManager::checkAlerts() const {
-    for (const auto& vehicle : vehicles) {
-        if (vehicle.getTemperature() > CRITICAL_TEMP) {
-            std::cout << "Vehicle ID " << vehicle.getId() 
-                     << ": Critical Overheating\n";
-        }
-        if (vehicle.getFuel() < LOW_FUEL_THRESHOLD) {
-            std::cout << "Vehicle ID " << vehicle.getId() 
-                     << ": Low Fuel Warning\n";
-        }
-    }
+    AlertReporter reporter;
+    reporter.format(evaluateAlerts(), columns.ids());
+    reporter.write();
+}
+
+/**
+ * @brief Checks all vehicles against a configured rule set and prints the alerts.
+ *
+ * All rules are evaluated in one fused pass, the matches are formatted in fleet order and written
+ * to standard output in one call. The fleet's current readings then become the rules' baseline, so
+ * delta rules (rise/drop) report change since the previous check.
+ *
+ * @param rules The rule engine to evaluate; its baseline is updated.
+ */
+void FleetManager::checkAlerts(AlertRuleEngine& rules) const {
+    AlertReporter reporter;
+    reporter.format(evaluateAlerts(rules), rules.rules(), columns.ids());
+    reporter.write();
+}
+
+/**
+ * @brief Prints only the alerts that were raised or cleared since the previous check.
+ *
+ * The fleet remembers which alerts are active for each vehicle (see AlertState), so a vehicle that
+ * stays overheated is reported once rather than on every check, and a cleared alert is reported
+ * when the reading is back past the hysteresis bound. Output is proportional to the number of
+ * changes. The state moves with its vehicle when removeVehicle refills a slot.
+ */
+void FleetManager::checkAlertChanges() {
+    AlertReporter reporter;
+    reporter.format(alertChanges(), columns.ids());
+    reporter.write();
+}
+
+/**
+ * @brief Brings the alert state of every vehicle up to date with its readings.
+ *
+ * @return The alerts raised and cleared since the previous update, indexed by fleet slot.
+ */
+AlertTransitions FleetManager::alertChanges() {
+    return alertStates.update(columns);
 }
 
+/**
+ * @brief Brings the alert state of one vehicle up to date with its current readings.
+ *
+ * For callers that apply readings one at a time, such as streaming ingestion; shares its state
+ * with the whole-fleet alertChanges.
+ *
+ * @param id Identifier of the vehicle.
+ * @return The AlertEdge flags of the alerts raised or cleared, or 0 if there are none or no
+ *         vehicle has that id.
+ */
+unsigned FleetManager::alertChanges(int id) {
+    std::size_t slot = slotsById.find(id);
+    if (slot == VehicleIndex::NPOS) return 0;
+    return alertStates.update(slot, id, columns.temperatures()[slot], columns.fuels()[slot]);
+}
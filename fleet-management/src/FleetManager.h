@@ -1,20 +1,97 @@
 #pragma once
 
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Vehicle.h"
+#include "FleetColumns.h"
+#include "FleetStats.h"
+#include "MetricHistogram.h"
+#include "AlertEngine.h"
+#include "AlertRules.h"
+#include "VehicleIndex.h"
+#include "TaskPool.h"
+#include "TelemetryHistory.h"
 
 class FleetManager {
+public:
+    static constexpr std::size_t DEFAULT_PARALLEL_THRESHOLD = 1 << 16;
+
 private:
-    std::vector<Vehicle> vehicles;
-    double avgSpeed{0.0};
-    double avgTemp{0.0};
-    double avgFuel{0.0};
+    FleetColumns columns;
+    VehicleIndex slotsById;
+    RunningFleetMoments moments;
+    std::optional<TelemetryHistory> readingHistory;
+    AlertState alertStates;
+
+    void indexColumns();
+    void appendVehicle(int id, double speed, double temperature, double fuel);
+    unsigned reductionThreads{0};
+    std::size_t parallelThreshold{DEFAULT_PARALLEL_THRESHOLD};
+    TaskPool* taskPool{nullptr};
+
+    bool usePool() const { return taskPool && columns.size() >= parallelThreshold; }
 
 public:
+    FleetManager() = default;
     explicit FleetManager(const std::vector<Vehicle>& fleet);
-    void computeAverages();  // No parameters needed
+    explicit FleetManager(std::vector<Vehicle>&& fleet);  // Releases the source buffer once transposed
+    explicit FleetManager(FleetColumns&& fleet);
+    std::size_t size() const { return columns.size(); }
+    bool contains(int id) const { return slotsById.find(id) != VehicleIndex::NPOS; }
+    std::size_t slotOf(int id) const { return slotsById.find(id); }  // VehicleIndex::NPOS if absent
+    void reserve(std::size_t capacity);
+    void addVehicle(const Vehicle& vehicle);
+    void addVehicle(Vehicle&& vehicle);
+    template<typename... Args>
+    void emplaceVehicle(Args&&... args) { appendVehicle(std::forward<Args>(args)...); }  // No Vehicle temporary
+    template<typename Range>
+    void addVehicles(const Range& vehicles);  // Reserves once for sized ranges
+    bool removeVehicle(int id);
+    bool updateReading(int id, double speed, double temperature, double fuel);
+    void upsertReading(int id, double speed, double temperature, double fuel);
+    void enableHistory(std::size_t capacity, std::size_t extremaWindow);  // Seeds it with current readings
+    const TelemetryHistory* history() const { return readingHistory ? &*readingHistory : nullptr; }
+    void setParallelism(unsigned threads, std::size_t serialThreshold = DEFAULT_PARALLEL_THRESHOLD);
+    void setTaskPool(TaskPool* pool) { taskPool = pool; }  // Scans run as chunks on the pool; nullptr = own threads
+    void computeAverages();  // Full rescan; re-anchors the running averages
     void checkAlerts() const;
+    void checkAlerts(AlertRuleEngine& rules) const;  // Configured rules; advances their baseline
+    void checkAlertChanges();  // Only alerts raised/cleared since the last check
+    AlertTransitions alertChanges();  // As checkAlertChanges, without output
+    unsigned alertChanges(int id);  // One vehicle only; AlertEdge flags
+    const AlertState& alertState() const { return alertStates; }
+    AlertMasks evaluateAlerts() const;  // Rule evaluation only, no output
+    RuleMasks evaluateAlerts(AlertRuleEngine& rules) const;  // As checkAlerts(rules), without output
     double averageSpeed() const;
     double averageTemperature() const;
     double averageFuel() const;
-};
\ No newline at end of file
+    const RunningFleetMoments& runningMoments() const { return moments; }
+    FleetStats statistics() const;  // One pass over all metric columns
+    FleetHistograms histograms() const;  // Quantile sketches, e.g. histograms().temperature.quantile(0.99)
+    const FleetColumns& fleetColumns() const { return columns; }
+};
+
+/**
+ * @brief Adds every vehicle of a range.
+ *
+ * When the range's iterators are at least forward iterators its length is known up front, and the
+ * columns and id index are grown once for the whole batch instead of repeatedly as it is appended.
+ *
+ * @param vehicles Any range of Vehicle (std::vector, std::deque, array, ...).
+ */
+template<typename Range>
+void FleetManager::addVehicles(const Range& vehicles) {
+    using std::begin;
+    using std::end;
+    using Iterator = decltype(begin(vehicles));
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>) {
+        reserve(size() + static_cast<std::size_t>(std::distance(begin(vehicles), end(vehicles))));
+    }
+    for (const Vehicle& vehicle : vehicles) {
+        addVehicle(vehicle);
+    }
+}
@@ -0,0 +1,72 @@
+#include "FleetReadView.h"
+#include "FleetManager.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+FleetReadView::FleetReadView(const FleetManager& fleet, std::uint64_t version)
+    : columns(fleet.fleetColumns()), moments(fleet.runningMoments()), viewVersion(version) {}
+
+FleetViewStore::FleetViewStore() : current(new FleetReadView()) {}
+
+FleetViewStore::~FleetViewStore() {
+    delete current.load();
+}
+
+/**
+ * @brief Claims a reader slot for the calling thread.
+ *
+ * @return A handle that releases the slot when destroyed.
+ *
+ * @throws std::runtime_error If MAX_READERS readers are already registered.
+ */
+FleetViewStore::Reader FleetViewStore::registerReader() {
+    for (ReaderSlot& slot : slots) {
+        bool expected = false;
+        if (slot.inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return Reader(*this, slot);
+        }
+    }
+    throw std::runtime_error("Too many fleet view readers");
+}
+
+/**
+ * @brief Pins and returns the current view.
+ *
+ * The reader announces the current epoch in its slot before loading the view pointer. Any view the
+ * writer replaces from then on is retired with an epoch no lower than the announced one, so it
+ * stays allocated until the returned Guard is destroyed. Wait-free: no lock, loop or retry.
+ *
+ * @return A guard through which the view can be read.
+ */
+FleetViewStore::Guard FleetViewStore::Reader::read() {
+    slot->epoch.store(store->globalEpoch.load());
+    return Guard(store->current.load(), &slot->epoch);
+}
+
+/**
+ * @brief Publishes a copy of the fleet as the new current view.
+ *
+ * Copying the columns costs O(fleet size) on the writer's side; readers are never blocked by it
+ * and keep seeing the previous view until the new one is swapped in. The replaced view is retired
+ * and every retired view no reader can still hold is freed.
+ *
+ * @param fleet The fleet to copy; only one thread may publish at a time.
+ */
+void FleetViewStore::publish(const FleetManager& fleet) {
+    const FleetReadView* previous = current.exchange(new FleetReadView(fleet, nextVersion++));
+    retired.emplace_back(globalEpoch.fetch_add(1), previous);
+    reclaim();
+}
+
+// Frees retired views older than the oldest read still in progress.
+void FleetViewStore::reclaim() {
+    std::uint64_t oldestRead = std::numeric_limits<std::uint64_t>::max();
+    for (const ReaderSlot& slot : slots) {
+        const std::uint64_t epoch = slot.epoch.load();
+        if (epoch != 0) oldestRead = std::min(oldestRead, epoch);
+    }
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [&](const auto& view) { return view.first < oldestRead; }),
+                  retired.end());
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "FleetColumns.h"
+#include "FleetStats.h"
+
+class FleetManager;
+
+// Immutable copy of the fleet columns and running averages at one moment.
+class FleetReadView {
+private:
+    FleetColumns columns;
+    RunningFleetMoments moments;
+    std::uint64_t viewVersion{0};
+
+public:
+    FleetReadView() = default;
+    FleetReadView(const FleetManager& fleet, std::uint64_t version);
+
+    std::uint64_t version() const { return viewVersion; }
+    std::size_t size() const { return columns.size(); }
+    const FleetColumns& fleetColumns() const { return columns; }
+    const RunningFleetMoments& runningMoments() const { return moments; }
+    double averageSpeed() const { return moments.speed.mean; }
+    double averageTemperature() const { return moments.temperature.mean; }
+    double averageFuel() const { return moments.fuel.mean; }
+};
+
+// Read-copy-update store of FleetReadViews. One writer publishes new views while
+// any number of registered readers pin the current one, each read costing a few
+// atomic operations that never wait for the writer or for each other. A replaced
+// view is freed once every reader active when it was replaced has let go
+// (epoch-based reclamation); the writer never waits for readers either.
+class FleetViewStore {
+public:
+    static constexpr std::size_t MAX_READERS = 64;
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{0};  // Epoch at which the current read began; 0 = idle
+        std::atomic<bool> inUse{false};
+    };
+
+    ReaderSlot slots[MAX_READERS];
+    std::atomic<const FleetReadView*> current;
+    std::atomic<std::uint64_t> globalEpoch{1};
+    std::uint64_t nextVersion{1};
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<const FleetReadView>>> retired;  // Writer-owned
+
+public:
+    // Pins one view for as long as it lives.
+    class Guard {
+    private:
+        const FleetReadView* view;
+        std::atomic<std::uint64_t>* slot;
+
+    public:
+        Guard(const FleetReadView* view, std::atomic<std::uint64_t>* slot) : view(view), slot(slot) {}
+        Guard(Guard&& other) noexcept : view(other.view), slot(std::exchange(other.slot, nullptr)) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+        ~Guard() {
+            if (slot) slot->store(0, std::memory_order_release);
+        }
+
+        const FleetReadView& operator*() const { return *view; }
+        const FleetReadView* operator->() const { return view; }
+    };
+
+    // One reader thread's registration. At most one Guard per Reader may be alive at a time.
+    class Reader {
+    private:
+        FleetViewStore* store;
+        ReaderSlot* slot;
+
+    public:
+        Reader(FleetViewStore& store, ReaderSlot& slot) : store(&store), slot(&slot) {}
+        Reader(Reader&& other) noexcept : store(other.store), slot(std::exchange(other.slot, nullptr)) {}
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+        ~Reader() {
+            if (slot) slot->inUse.store(false, std::memory_order_release);
+        }
+
+        Guard read();
+    };
+
+    FleetViewStore();
+    ~FleetViewStore();  // Every Reader must be gone
+
+    FleetViewStore(const FleetViewStore&) = delete;
+    FleetViewStore& operator=(const FleetViewStore&) = delete;
+
+    Reader registerReader();
+    void publish(const FleetManager& fleet);  // Single writer
+    void reclaim();  // Writer side; publish() also reclaims, this frees views between publishes
+    std::size_t retiredViews() const { return retired.size(); }  // Writer side; awaiting reclamation
+};
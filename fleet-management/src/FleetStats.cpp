@@ -0,0 +1,207 @@
+#include "FleetStats.h"
+#include "TaskPool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Running sums of one metric, shifted by a reference value so that the sum of squares
+    // does not cancel catastrophically when the spread is small relative to the values.
+    struct ShiftedSums {
+        double shift;
+        double sum{0.0};
+        double sumSquares{0.0};
+        double min{std::numeric_limits<double>::infinity()};
+        double max{-std::numeric_limits<double>::infinity()};
+
+        explicit ShiftedSums(double reference) : shift(reference) {}
+
+        void add(double value) {
+            double d = value - shift;
+            sum += d;
+            sumSquares += d * d;
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        MetricStats finish(std::size_t count) const {
+            MetricStats stats;
+            if (count == 0) return stats;
+            double n = static_cast<double>(count);
+            stats.count = count;
+            stats.mean = shift + sum / n;
+            stats.m2 = std::max(0.0, sumSquares - sum * sum / n);
+            stats.min = min;
+            stats.max = max;
+            return stats;
+        }
+    };
+}
+
+double MetricStats::stddev() const { return std::sqrt(variance()); }
+
+/**
+ * @brief Adds one sample using Welford's update.
+ *
+ * @param value The sample to fold into the statistics.
+ */
+void MetricStats::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+/**
+ * @brief Combines the statistics of a disjoint set of samples into this one.
+ *
+ * Uses Chan et al.'s pairwise update, so partial results from separate ranges or threads
+ * merge to the same mean and variance as a single pass over all samples.
+ *
+ * @param other Statistics of the other set of samples.
+ */
+void MetricStats::merge(const MetricStats& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    double n = static_cast<double>(count + other.count);
+    double delta = other.mean - mean;
+    mean += delta * (other.count / n);
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+void FleetStats::merge(const FleetStats& other) {
+    speed.merge(other.speed);
+    temperature.merge(other.temperature);
+    fuel.merge(other.fuel);
+}
+
+/**
+ * @brief Adds one sample using Welford's update.
+ *
+ * @param value The sample entering the population.
+ */
+void RunningMoments::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+/**
+ * @brief Removes one previously added sample by running Welford's update backwards.
+ *
+ * Removing the last sample resets the moments exactly; otherwise m2 is clamped at zero so that
+ * accumulated rounding can never produce a negative variance.
+ *
+ * @param value The sample leaving the population; must have been added before.
+ */
+void RunningMoments::remove(double value) {
+    if (count <= 1) {
+        *this = RunningMoments();
+        return;
+    }
+    double oldMean = mean;
+    --count;
+    mean = (oldMean * (count + 1) - value) / count;
+    m2 = std::max(0.0, m2 - (value - oldMean) * (value - mean));
+}
+
+/**
+ * @brief Replaces one sample by another without changing the count.
+ *
+ * @param oldValue The sample currently in the population.
+ * @param newValue The sample taking its place.
+ */
+void RunningMoments::replace(double oldValue, double newValue) {
+    if (count == 0) return;
+    double oldMean = mean;
+    mean += (newValue - oldValue) / count;
+    m2 = std::max(0.0, m2 + (newValue - oldValue) * (newValue - mean + oldValue - oldMean));
+}
+
+void RunningMoments::reset(const MetricStats& stats) {
+    count = stats.count;
+    mean = stats.mean;
+    m2 = stats.m2;
+}
+
+void RunningFleetMoments::add(double speedValue, double temperatureValue, double fuelValue) {
+    speed.add(speedValue);
+    temperature.add(temperatureValue);
+    fuel.add(fuelValue);
+}
+
+void RunningFleetMoments::remove(double speedValue, double temperatureValue, double fuelValue) {
+    speed.remove(speedValue);
+    temperature.remove(temperatureValue);
+    fuel.remove(fuelValue);
+}
+
+void RunningFleetMoments::reset(const FleetStats& stats) {
+    speed.reset(stats.speed);
+    temperature.reset(stats.temperature);
+    fuel.reset(stats.fuel);
+}
+
+/**
+ * @brief Computes count, mean, min, max and variance of speed, temperature and fuel in one pass.
+ *
+ * A single loop walks the requested slot range and reads all three metric columns side by side,
+ * keeping shifted sum / sum-of-squares / min / max accumulators per metric. Each metric is shifted
+ * by its first sample, which keeps the variance accurate without a second pass over the data.
+ *
+ * @param columns The fleet store to aggregate.
+ * @param first Index of the first slot to include.
+ * @param last Index one past the last slot to include.
+ * @return The statistics of the slots in [first, last); all counts are zero for an empty range.
+ */
+FleetStats computeFleetStats(const FleetColumns& columns, std::size_t first, std::size_t last) {
+    FleetStats stats;
+    if (first >= last) return stats;
+
+    const double* speeds = columns.speeds();
+    const double* temperatures = columns.temperatures();
+    const double* fuels = columns.fuels();
+
+    ShiftedSums speed(speeds[first]);
+    ShiftedSums temperature(temperatures[first]);
+    ShiftedSums fuel(fuels[first]);
+    for (std::size_t i = first; i < last; ++i) {
+        speed.add(speeds[i]);
+        temperature.add(temperatures[i]);
+        fuel.add(fuels[i]);
+    }
+
+    std::size_t count = last - first;
+    stats.speed = speed.finish(count);
+    stats.temperature = temperature.finish(count);
+    stats.fuel = fuel.finish(count);
+    return stats;
+}
+
+FleetStats computeFleetStats(const FleetColumns& columns) {
+    return computeFleetStats(columns, 0, columns.size());
+}
+
+/**
+ * @brief Computes FleetStats as TaskPool::FLEET_CHUNK-sized chunks on a work-stealing pool.
+ *
+ * Chunk statistics are merged in chunk order, so the result does not depend on scheduling.
+ */
+FleetStats computeFleetStats(const FleetColumns& columns, TaskPool& pool) {
+    std::vector<FleetStats> partials((columns.size() + TaskPool::FLEET_CHUNK - 1) / TaskPool::FLEET_CHUNK);
+    pool.parallelFor(columns.size(), TaskPool::FLEET_CHUNK, [&](std::size_t first, std::size_t last) {
+        partials[first / TaskPool::FLEET_CHUNK] = computeFleetStats(columns, first, last);
+    });
+    FleetStats stats;
+    for (const FleetStats& partial : partials) stats.merge(partial);
+    return stats;
+}
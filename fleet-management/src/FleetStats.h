@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include "FleetColumns.h"
+
+class TaskPool;
+
+// Summary statistics of one metric: count, mean, min, max and the sum of squared
+// deviations from the mean (m2), from which the variance follows.
+struct MetricStats {
+    std::size_t count{0};
+    double mean{0.0};
+    double m2{0.0};
+    double min{std::numeric_limits<double>::infinity()};
+    double max{-std::numeric_limits<double>::infinity()};
+
+    double sum() const { return mean * count; }
+    double variance() const { return count ? m2 / count : 0.0; }
+    double stddev() const;
+
+    void add(double value);
+    void merge(const MetricStats& other);
+};
+
+// Statistics for every metric of the fleet, produced by one traversal.
+struct FleetStats {
+    MetricStats speed;
+    MetricStats temperature;
+    MetricStats fuel;
+
+    std::size_t count() const { return speed.count; }
+    void merge(const FleetStats& other);
+};
+
+// Count, mean and m2 of one metric maintained under insertions and removals, so the
+// mean and variance stay current in O(1) per change without rescanning.
+struct RunningMoments {
+    std::size_t count{0};
+    double mean{0.0};
+    double m2{0.0};
+
+    double variance() const { return count ? m2 / count : 0.0; }
+
+    void add(double value);
+    void remove(double value);
+    void replace(double oldValue, double newValue);
+    void reset(const MetricStats& stats);
+};
+
+// Running moments of every metric of the fleet.
+struct RunningFleetMoments {
+    RunningMoments speed;
+    RunningMoments temperature;
+    RunningMoments fuel;
+
+    void add(double speedValue, double temperatureValue, double fuelValue);
+    void remove(double speedValue, double temperatureValue, double fuelValue);
+    void reset(const FleetStats& stats);
+};
+
+// Computes FleetStats for slots [first, last) of the columns in a single pass.
+FleetStats computeFleetStats(const FleetColumns& columns, std::size_t first, std::size_t last);
+FleetStats computeFleetStats(const FleetColumns& columns);
+FleetStats computeFleetStats(const FleetColumns& columns, TaskPool& pool);  // Chunked on the pool
@@ -0,0 +1,122 @@
+#include "Instrumentation.h"
+#include <cstdio>
+
+namespace instrumentation {
+    namespace {
+        constexpr int STAGES = static_cast<int>(Stage::Count);
+        constexpr int COUNTERS = static_cast<int>(Counter::Count);
+
+        constexpr const char* STAGE_NAMES[STAGES] = {
+            "load", "computeAverages", "evaluateAlerts", "formatAlerts", "writeAlerts", "ingest", "writeSnapshot"};
+        constexpr const char* COUNTER_NAMES[COUNTERS] = {"rowsParsed", "parseFailures", "alertsEmitted", "bytesRead"};
+
+        struct StageSlot {
+            std::atomic<std::uint64_t> calls{0};
+            std::atomic<std::uint64_t> totalNanoseconds{0};
+            std::atomic<std::uint64_t> maxNanoseconds{0};
+        };
+
+        StageSlot stages[STAGES];
+        std::atomic<std::uint64_t> counters[COUNTERS];
+    }
+
+    namespace detail {
+        std::atomic<bool> active{false};
+
+        void addCounter(Counter counter, std::uint64_t amount) {
+            counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Switches instrumentation on or off; totals gathered so far are kept.
+     */
+    void enable(bool on) { detail::active.store(on, std::memory_order_relaxed); }
+
+    /**
+     * @brief Clears every stage total and counter.
+     */
+    void reset() {
+        for (StageSlot& slot : stages) {
+            slot.calls.store(0, std::memory_order_relaxed);
+            slot.totalNanoseconds.store(0, std::memory_order_relaxed);
+            slot.maxNanoseconds.store(0, std::memory_order_relaxed);
+        }
+        for (auto& value : counters) value.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds one timed call to a stage. Safe to call from any thread.
+     *
+     * @param stage The pipeline stage that ran.
+     * @param nanoseconds Wall-clock duration of the call.
+     */
+    void record(Stage stage, std::uint64_t nanoseconds) {
+        StageSlot& slot = stages[static_cast<int>(stage)];
+        slot.calls.fetch_add(1, std::memory_order_relaxed);
+        slot.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        std::uint64_t seen = slot.maxNanoseconds.load(std::memory_order_relaxed);
+        while (nanoseconds > seen
+               && !slot.maxNanoseconds.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t counter(Counter counter) {
+        return counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+    }
+
+    StageTotals stage(Stage stage) {
+        const StageSlot& slot = stages[static_cast<int>(stage)];
+        return {slot.calls.load(std::memory_order_relaxed), slot.totalNanoseconds.load(std::memory_order_relaxed),
+                slot.maxNanoseconds.load(std::memory_order_relaxed)};
+    }
+
+    const char* name(Stage stage) { return STAGE_NAMES[static_cast<int>(stage)]; }
+    const char* name(Counter counter) { return COUNTER_NAMES[static_cast<int>(counter)]; }
+
+    /**
+     * @brief Writes a human-readable table of the stages that ran, followed by all counters.
+     *
+     * @param out Destination stream (main uses std::cerr so normal output is unaffected).
+     */
+    void writeSummary(std::ostream& out) {
+        char line[96];
+        out << "\n--- Profile ---\n\n";
+        std::snprintf(line, sizeof(line), "%-16s %8s %14s %14s\n", "Stage", "Calls", "Total ms", "Max ms");
+        out << line;
+        for (int i = 0; i < STAGES; ++i) {
+            StageTotals totals = stage(static_cast<Stage>(i));
+            if (totals.calls == 0) continue;
+            std::snprintf(line, sizeof(line), "%-16s %8llu %14.3f %14.3f\n", STAGE_NAMES[i],
+                          static_cast<unsigned long long>(totals.calls), totals.totalNanoseconds / 1e6,
+                          totals.maxNanoseconds / 1e6);
+            out << line;
+        }
+        out << "\n";
+        for (int i = 0; i < COUNTERS; ++i) {
+            out << COUNTER_NAMES[i] << ": " << counter(static_cast<Counter>(i)) << "\n";
+        }
+    }
+
+    /**
+     * @brief Writes every stage and counter as one JSON object.
+     *
+     * Layout: {"stages": {"<name>": {"calls": n, "total_ns": n, "max_ns": n}, ...},
+     *          "counters": {"<name>": n, ...}}
+     *
+     * @param out Destination stream.
+     */
+    void writeJson(std::ostream& out) {
+        out << "{\n  \"stages\": {";
+        for (int i = 0; i < STAGES; ++i) {
+            StageTotals totals = stage(static_cast<Stage>(i));
+            out << (i ? ",\n" : "\n") << "    \"" << STAGE_NAMES[i] << "\": {\"calls\": " << totals.calls
+                << ", \"total_ns\": " << totals.totalNanoseconds << ", \"max_ns\": " << totals.maxNanoseconds << "}";
+        }
+        out << "\n  },\n  \"counters\": {";
+        for (int i = 0; i < COUNTERS; ++i) {
+            out << (i ? ",\n" : "\n") << "    \"" << COUNTER_NAMES[i] << "\": " << counter(static_cast<Counter>(i));
+        }
+        out << "\n  }\n}\n";
+    }
+}
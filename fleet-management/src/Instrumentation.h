@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Runtime-switchable pipeline instrumentation: per-stage wall-clock timers and
+// event counters, dumped as a text summary or JSON. While disabled every hook is
+// one relaxed atomic load and a branch; hooks sit at stage and batch granularity,
+// never per row.
+namespace instrumentation {
+    enum class Stage { Load, ComputeAverages, EvaluateAlerts, FormatAlerts, WriteAlerts, Ingest, WriteSnapshot, Count };
+    enum class Counter { RowsParsed, ParseFailures, AlertsEmitted, BytesRead, Count };
+
+    struct StageTotals {
+        std::uint64_t calls;
+        std::uint64_t totalNanoseconds;
+        std::uint64_t maxNanoseconds;
+    };
+
+    namespace detail {
+        extern std::atomic<bool> active;
+        void addCounter(Counter counter, std::uint64_t amount);
+    }
+
+    inline bool enabled() { return detail::active.load(std::memory_order_relaxed); }
+    void enable(bool on = true);
+    void reset();
+
+    inline void add(Counter counter, std::uint64_t amount = 1) {
+        if (enabled()) detail::addCounter(counter, amount);
+    }
+    void record(Stage stage, std::uint64_t nanoseconds);
+
+    std::uint64_t counter(Counter counter);
+    StageTotals stage(Stage stage);
+    const char* name(Stage stage);
+    const char* name(Counter counter);
+
+    void writeSummary(std::ostream& out);
+    void writeJson(std::ostream& out);
+
+    // Times the enclosing scope into `stage` if instrumentation was enabled when it began.
+    class ScopedTimer {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Stage timedStage;
+        bool active;
+        Clock::time_point start;
+
+    public:
+        explicit ScopedTimer(Stage stage) : timedStage(stage), active(enabled()) {
+            if (active) start = Clock::now();
+        }
+        ~ScopedTimer() {
+            if (active) {
+                record(timedStage, static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+}
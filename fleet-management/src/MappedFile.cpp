@@ -0,0 +1,128 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Maps the whole of a file into memory for read-only access.
+ *
+ * An empty file is valid and yields a mapping with size() == 0 and a null data() pointer,
+ * since zero-length mappings are rejected by both POSIX and Win32.
+ *
+ * @param filename The path to the file to map.
+ *
+ * @throws std::runtime_error If the file cannot be opened, inspected or mapped.
+ */
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filename) {
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        release();
+        throw std::runtime_error("Unable to stat file: " + filename);
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        release();
+        throw std::runtime_error("Unable to map file: " + filename);
+    }
+    mappingHandle = mapping;
+
+    bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (bytes == nullptr) {
+        release();
+        throw std::runtime_error("Unable to map file: " + filename);
+    }
+}
+
+void MappedFile::release() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+#else
+MappedFile::MappedFile(const std::string& filename) {
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        release();
+        throw std::runtime_error("Unable to stat file: " + filename);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length == 0) return;
+
+    void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        release();
+        throw std::runtime_error("Unable to map file: " + filename);
+    }
+    bytes = static_cast<const char*>(addr);
+    // The loaders walk the file front to back exactly once.
+    ::madvise(addr, length, MADV_SEQUENTIAL);
+}
+
+void MappedFile::release() {
+    if (bytes) ::munmap(const_cast<char*>(bytes), length);
+    if (fd >= 0) ::close(fd);
+    bytes = nullptr;
+    length = 0;
+    fd = -1;
+}
+#endif
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : bytes(other.bytes), length(other.length),
+#ifdef _WIN32
+      fileHandle(other.fileHandle), mappingHandle(other.mappingHandle) {
+    other.fileHandle = nullptr;
+    other.mappingHandle = nullptr;
+#else
+      fd(other.fd) {
+    other.fd = -1;
+#endif
+    other.bytes = nullptr;
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(bytes, other.bytes);
+        std::swap(length, other.length);
+#ifdef _WIN32
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#else
+        std::swap(fd, other.fd);
+#endif
+    }
+    return *this;
+}
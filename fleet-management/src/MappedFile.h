@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. The mapping is released when the
+// object is destroyed; the object is movable but not copyable.
+class MappedFile {
+private:
+    const char* bytes{nullptr};
+    std::size_t length{0};
+#ifdef _WIN32
+    void* fileHandle{nullptr};
+    void* mappingHandle{nullptr};
+#else
+    int fd{-1};
+#endif
+
+    void release();
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    const char* begin() const { return bytes; }
+    const char* end() const { return bytes + length; }
+};
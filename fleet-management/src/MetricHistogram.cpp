@@ -0,0 +1,210 @@
+#include "MetricHistogram.h"
+#include "TaskPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <thread>
+
+namespace {
+    // Bits of a double below its exponent and top SUB_BUCKET_BITS mantissa bits.
+    constexpr int DROPPED_BITS = 52 - MetricHistogram::SUB_BUCKET_BITS;
+    // (biased exponent, top mantissa bits) of 2^MIN_EXPONENT, the first bucket of either sign.
+    constexpr std::uint64_t FIRST_BUCKET_BITS = std::uint64_t(MetricHistogram::MIN_EXPONENT + 1023)
+                                                << MetricHistogram::SUB_BUCKET_BITS;
+    constexpr std::size_t ZERO = MetricHistogram::MAGNITUDE_BUCKETS;
+    const double MIN_MAGNITUDE = std::ldexp(1.0, MetricHistogram::MIN_EXPONENT);
+
+    // Worker ranges are whole multiples of this many vehicles.
+    constexpr std::size_t RANGE_GRAIN = 4096;
+
+    // Index among the magnitude buckets of |value| >= MIN_MAGNITUDE. For positive doubles the
+    // bit pattern is monotonic in the value, so exponent and leading mantissa bits read straight
+    // off it form the log-linear bucket number.
+    std::size_t magnitudeBucket(double magnitude) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &magnitude, sizeof bits);
+        return static_cast<std::size_t>(
+            std::min<std::uint64_t>((bits >> DROPPED_BITS) - FIRST_BUCKET_BITS, MetricHistogram::MAGNITUDE_BUCKETS - 1));
+    }
+
+    double fromBits(std::uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+}
+
+MetricHistogram::MetricHistogram() : counts(2 * MAGNITUDE_BUCKETS + 1, 0) {
+    clear();
+}
+
+std::size_t MetricHistogram::bucketOf(double value) {
+    const double magnitude = std::fabs(value);
+    if (magnitude < MIN_MAGNITUDE) return ZERO;
+    const std::size_t bucket = magnitudeBucket(magnitude);
+    return value > 0 ? ZERO + 1 + bucket : ZERO - 1 - bucket;
+}
+
+// Midpoint of a bucket's value range; 0 for the zero bucket.
+double MetricHistogram::bucketValue(std::size_t bucket) {
+    if (bucket == ZERO) return 0.0;
+    const std::uint64_t magnitude = bucket > ZERO ? bucket - ZERO - 1 : ZERO - 1 - bucket;
+    const std::uint64_t bits = (magnitude + FIRST_BUCKET_BITS) << DROPPED_BITS;
+    const double middle = (fromBits(bits) + fromBits(bits + (std::uint64_t(1) << DROPPED_BITS))) / 2;
+    return bucket > ZERO ? middle : -middle;
+}
+
+/**
+ * @brief Counts one value in its bucket in O(1).
+ *
+ * @param value The value to add; NaN is ignored.
+ */
+void MetricHistogram::add(double value) {
+    if (std::isnan(value)) return;
+    ++counts[bucketOf(value)];
+    ++total;
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+}
+
+/**
+ * @brief Counts a column of values; same result as adding them one by one.
+ *
+ * The bucket number is computed without branches from each value's bits, and min, max and the
+ * count are kept in registers for the whole column.
+ *
+ * @param values Pointer to the first value.
+ * @param count Number of values.
+ */
+void MetricHistogram::add(const double* values, std::size_t count) {
+    constexpr std::uint64_t SIGN = std::uint64_t(1) << 63;
+    constexpr std::uint64_t LAST = MAGNITUDE_BUCKETS - 1;
+    std::uint64_t* bucketCounts = counts.data();
+    double low = minimum, high = maximum;
+    std::uint64_t added = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double value = values[i];
+        if (value != value) continue;  // NaN
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        const std::uint64_t key = (bits & ~SIGN) >> DROPPED_BITS;
+        const std::uint64_t bucket = std::min(key - FIRST_BUCKET_BITS, LAST);
+        const std::size_t index = key < FIRST_BUCKET_BITS ? ZERO : (bits & SIGN ? ZERO - 1 - bucket : ZERO + 1 + bucket);
+        ++bucketCounts[index];
+        ++added;
+        low = value < low ? value : low;
+        high = value > high ? value : high;
+    }
+    total += added;
+    minimum = low;
+    maximum = high;
+}
+
+/**
+ * @brief Adds the counts of another histogram, as if its values had been added to this one.
+ *
+ * @param other Histogram of a disjoint set of values.
+ */
+void MetricHistogram::merge(const MetricHistogram& other) {
+    if (other.total == 0) return;
+    for (std::size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+    total += other.total;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+}
+
+void MetricHistogram::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    minimum = std::numeric_limits<double>::infinity();
+    maximum = -std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Returns the value below which a fraction q of the values lie (nearest rank).
+ *
+ * Walks the buckets in value order to the one holding rank ceil(q * count) and returns its
+ * midpoint, clamped to the exact min and max; q = 0 and q = 1 return min() and max(). Costs
+ * O(buckets), independent of count().
+ *
+ * @param q The quantile, e.g. 0.5 for the median or 0.99 for p99; clamped to [0, 1].
+ * @return The quantile, or NaN if the histogram is empty.
+ */
+double MetricHistogram::quantile(double q) const {
+    if (total == 0) return std::numeric_limits<double>::quiet_NaN();
+    q = std::clamp(q, 0.0, 1.0);
+    if (q == 0.0) return minimum;
+    if (q == 1.0) return maximum;
+
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * total)));
+    std::uint64_t seen = 0;
+    std::size_t bucket = 0;
+    while ((seen += counts[bucket]) < rank) ++bucket;
+    return std::clamp(bucketValue(bucket), minimum, maximum);
+}
+
+void FleetHistograms::merge(const FleetHistograms& other) {
+    speed.merge(other.speed);
+    temperature.merge(other.temperature);
+    fuel.merge(other.fuel);
+}
+
+FleetHistograms computeFleetHistograms(const FleetColumns& columns, std::size_t first, std::size_t last) {
+    FleetHistograms histograms;
+    histograms.speed.add(columns.speeds() + first, last - first);
+    histograms.temperature.add(columns.temperatures() + first, last - first);
+    histograms.fuel.add(columns.fuels() + first, last - first);
+    return histograms;
+}
+
+/**
+ * @brief Builds the speed, temperature and fuel histograms, in parallel for large fleets.
+ *
+ * Each worker fills its own histograms for one contiguous slot range, and the partial results are
+ * merged bucket by bucket; the result is identical to a serial pass.
+ *
+ * @param columns The fleet store to scan.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency().
+ * @param serialThreshold Minimum fleet size for which the work is split across threads.
+ * @return The histograms of every metric column.
+ */
+FleetHistograms parallelFleetHistograms(const FleetColumns& columns, unsigned threads, std::size_t serialThreshold) {
+    const std::size_t size = columns.size();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t grains = (size + RANGE_GRAIN - 1) / RANGE_GRAIN;
+    std::size_t workers = std::min<std::size_t>(threads, grains);
+    if (size < serialThreshold || workers <= 1) {
+        return computeFleetHistograms(columns, 0, size);
+    }
+
+    auto bound = [&](std::size_t i) { return std::min(size, grains * i / workers * RANGE_GRAIN); };
+    std::vector<std::future<FleetHistograms>> pending;
+    for (std::size_t i = 1; i < workers; ++i) {
+        pending.push_back(std::async(std::launch::async, computeFleetHistograms, std::cref(columns), bound(i), bound(i + 1)));
+    }
+    FleetHistograms histograms = computeFleetHistograms(columns, 0, bound(1));
+    for (auto& partial : pending) histograms.merge(partial.get());
+    return histograms;
+}
+
+/**
+ * @brief Builds the histograms on a work-stealing pool.
+ *
+ * A partial set of histograms is 168 KiB, so chunks are sized for about four per worker (and at least
+ * TaskPool::FLEET_CHUNK vehicles) rather than one per cache-sized block; that still leaves room
+ * to steal while keeping allocation and merging negligible.
+ */
+FleetHistograms parallelFleetHistograms(const FleetColumns& columns, TaskPool& pool) {
+    const std::size_t target = (columns.size() + 4 * pool.workers() - 1) / (4 * pool.workers());
+    const std::size_t grain = std::max<std::size_t>(1, (target + TaskPool::FLEET_CHUNK - 1) / TaskPool::FLEET_CHUNK) *
+                              TaskPool::FLEET_CHUNK;
+    std::vector<FleetHistograms> partials((columns.size() + grain - 1) / grain);
+    pool.parallelFor(columns.size(), grain, [&](std::size_t first, std::size_t last) {
+        partials[first / grain] = computeFleetHistograms(columns, first, last);
+    });
+    FleetHistograms histograms;
+    for (const FleetHistograms& partial : partials) histograms.merge(partial);
+    return histograms;
+}
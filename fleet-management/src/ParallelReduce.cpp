@@ -0,0 +1,118 @@
+#include "ParallelReduce.h"
+#include "SimdKernels.h"
+#include "TaskPool.h"
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Elements summed by one vector kernel call; 4096 doubles = 32 KiB, one L1-sized block.
+    constexpr std::size_t BLOCK = 4096;
+
+    struct KahanSum {
+        double sum{0.0};
+        double compensation{0.0};
+
+        void add(double value) {
+            double y = value - compensation;
+            double t = sum + y;
+            compensation = (t - sum) - y;
+            sum = t;
+        }
+    };
+
+    ColumnSums sumRange(const FleetColumns& columns, std::size_t first, std::size_t last) {
+        ColumnSums sums;
+        sums.speed = stableSum(columns.speeds() + first, last - first);
+        sums.temperature = stableSum(columns.temperatures() + first, last - first);
+        sums.fuel = stableSum(columns.fuels() + first, last - first);
+        return sums;
+    }
+}
+
+/**
+ * @brief Sums a column with bounded rounding error.
+ *
+ * The column is cut into L1-sized blocks; each block is summed with the vectorized simd::sum kernel
+ * and the block totals are accumulated with Kahan compensation. The error therefore depends on the
+ * block size rather than on the total length of the column.
+ *
+ * @param values Pointer to the first element of the column.
+ * @param count Number of elements to sum.
+ * @return The compensated sum, or 0.0 if count is zero.
+ */
+double stableSum(const double* values, std::size_t count) {
+    KahanSum total;
+    for (std::size_t i = 0; i < count; i += BLOCK) {
+        total.add(simd::sum(values + i, std::min(BLOCK, count - i)));
+    }
+    return total.sum;
+}
+
+/**
+ * @brief Computes the speed, temperature and fuel column sums, in parallel for large fleets.
+ *
+ * Fleets smaller than serialThreshold are summed on the calling thread. Larger fleets are split
+ * into one contiguous, block-aligned slot range per worker; each worker produces stable partial
+ * sums for its range and the partials are combined in range order with Kahan summation, so the
+ * result for a given thread count is deterministic.
+ *
+ * @param columns The fleet store to sum.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency().
+ * @param serialThreshold Minimum fleet size for which the work is split across threads.
+ * @return The sum of each metric column.
+ */
+ColumnSums sumColumns(const FleetColumns& columns, unsigned threads, std::size_t serialThreshold) {
+    const std::size_t size = columns.size();
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t blocks = (size + BLOCK - 1) / BLOCK;
+    std::size_t workers = std::min<std::size_t>(threads, blocks);
+    if (size < serialThreshold || workers <= 1) {
+        return sumRange(columns, 0, size);
+    }
+
+    auto bound = [&](std::size_t i) { return std::min(size, blocks * i / workers * BLOCK); };
+
+    // The calling thread sums the first range itself.
+    std::vector<std::future<ColumnSums>> pending;
+    for (std::size_t i = 1; i < workers; ++i) {
+        pending.push_back(std::async(std::launch::async, sumRange, std::cref(columns), bound(i), bound(i + 1)));
+    }
+    std::vector<ColumnSums> partials{sumRange(columns, 0, bound(1))};
+    for (auto& partial : pending) partials.push_back(partial.get());
+
+    KahanSum speed, temperature, fuel;
+    for (const auto& partial : partials) {
+        speed.add(partial.speed);
+        temperature.add(partial.temperature);
+        fuel.add(partial.fuel);
+    }
+    return {speed.sum, temperature.sum, fuel.sum};
+}
+
+/**
+ * @brief Computes the column sums as TaskPool::FLEET_CHUNK-sized chunks on a work-stealing pool.
+ *
+ * Each chunk's stable partial sums land in their own slot and are combined in chunk order, so the
+ * result depends only on the chunk size, never on which worker ran which chunk.
+ *
+ * @param columns The fleet store to sum.
+ * @param pool The pool to run the chunks on; the calling thread helps.
+ * @return The sum of each metric column.
+ */
+ColumnSums sumColumns(const FleetColumns& columns, TaskPool& pool) {
+    const std::size_t chunks = (columns.size() + TaskPool::FLEET_CHUNK - 1) / TaskPool::FLEET_CHUNK;
+    std::vector<ColumnSums> partials(chunks);
+    pool.parallelFor(columns.size(), TaskPool::FLEET_CHUNK, [&](std::size_t first, std::size_t last) {
+        partials[first / TaskPool::FLEET_CHUNK] = sumRange(columns, first, last);
+    });
+
+    KahanSum speed, temperature, fuel;
+    for (const auto& partial : partials) {
+        speed.add(partial.speed);
+        temperature.add(partial.temperature);
+        fuel.add(partial.fuel);
+    }
+    return {speed.sum, temperature.sum, fuel.sum};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include "FleetColumns.h"
+
+class TaskPool;
+
+// Sums of the three metric columns over the whole fleet.
+struct ColumnSums {
+    double speed{0.0};
+    double temperature{0.0};
+    double fuel{0.0};
+};
+
+// Compensated sum of one column: vectorized sums of fixed-size blocks, combined
+// with Kahan summation so rounding error does not grow with the column length.
+double stableSum(const double* values, std::size_t count);
+
+// Sums every metric column, splitting the fleet across `threads` workers
+// (0 = hardware concurrency) once it holds at least `serialThreshold` vehicles.
+ColumnSums sumColumns(const FleetColumns& columns, unsigned threads, std::size_t serialThreshold);
+
+// Same, as cache-sized chunks on a work-stealing pool; deterministic for any pool size.
+ColumnSums sumColumns(const FleetColumns& columns, TaskPool& pool);
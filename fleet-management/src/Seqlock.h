@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <thread>
+
+// Single-writer sequence lock publishing a small trivially copyable value. The
+// writer never waits; readers retry if a write overlapped their copy, so a read
+// returns a value exactly as one store() left it. The value is kept in atomic
+// words, which makes the racing reads well defined.
+template<typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied word by word");
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> sequence{0};  // Odd while a store is in progress
+    std::atomic<std::uint64_t> words[WORDS] = {};
+
+public:
+    // Writer side; calls must not overlap.
+    void store(const T& value) {
+        std::uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        const std::uint64_t s = sequence.load(std::memory_order_relaxed);
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) words[i].store(buffer[i], std::memory_order_relaxed);
+        sequence.store(s + 2, std::memory_order_release);
+    }
+
+    // Any thread; never blocks the writer.
+    T load() const {
+        std::uint64_t buffer[WORDS];
+        for (;;) {
+            const std::uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < WORDS; ++i) buffer[i] = words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+};
@@ -0,0 +1,211 @@
+#include "ShardedFleetManager.h"
+#include "AlertEngine.h"
+#include <algorithm>
+
+namespace {
+    ShardSummary& operator+=(ShardSummary& total, const ShardSummary& shard) {
+        total.vehicles += shard.vehicles;
+        total.speedSum += shard.speedSum;
+        total.temperatureSum += shard.temperatureSum;
+        total.fuelSum += shard.fuelSum;
+        total.overheating += shard.overheating;
+        total.lowFuel += shard.lowFuel;
+        return total;
+    }
+
+    bool overheating(double temperature) { return temperature > AlertThresholds::CRITICAL_TEMP; }
+    bool lowFuel(double fuel) { return fuel < AlertThresholds::LOW_FUEL_THRESHOLD; }
+}
+
+/**
+ * @brief Creates an empty fleet split into `shards` partitions, each with its own worker thread.
+ *
+ * @param shards Number of shards; 0 uses std::thread::hardware_concurrency().
+ */
+ShardedFleetManager::ShardedFleetManager(std::size_t shards) {
+    if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < shards; ++i) shardList.push_back(std::make_unique<Shard>());
+    startWorkers();
+}
+
+/**
+ * @brief Distributes an existing fleet across the shards by id hash.
+ *
+ * @param fleet The vehicles to manage; copied into the shards.
+ * @param shards Number of shards; 0 uses std::thread::hardware_concurrency().
+ */
+ShardedFleetManager::ShardedFleetManager(const FleetColumns& fleet, std::size_t shards) {
+    if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < shards; ++i) shardList.push_back(std::make_unique<Shard>());
+    for (std::size_t slot = 0; slot < fleet.size(); ++slot) {
+        Shard& shard = *shardList[shardOf(fleet.ids()[slot])];
+        shard.fleet.upsertReading(fleet.ids()[slot], fleet.speeds()[slot], fleet.temperatures()[slot],
+                                  fleet.fuels()[slot]);
+    }
+    for (auto& shard : shardList) {
+        AlertMasks masks = shard->fleet.evaluateAlerts();
+        shard->overheating = masks.overheatingCount();
+        shard->lowFuel = masks.lowFuelCount();
+    }
+    startWorkers();
+}
+
+ShardedFleetManager::~ShardedFleetManager() {
+    for (auto& shard : shardList) {
+        {
+            std::lock_guard<std::mutex> lock(shard->mailboxLock);
+            shard->stopping = true;
+        }
+        shard->pending.notify_one();
+    }
+    for (auto& shard : shardList) shard->worker.join();
+}
+
+void ShardedFleetManager::startWorkers() {
+    for (auto& shard : shardList) {
+        publish(*shard);
+        shard->worker = std::thread(run, std::ref(*shard));
+    }
+}
+
+/**
+ * @brief Returns the shard that owns a vehicle id.
+ *
+ * The id is mixed before being mapped onto the shards, so consecutive ids spread evenly, and the
+ * mix differs from VehicleIndex's so a shard's own index does not inherit the partitioning.
+ */
+std::size_t ShardedFleetManager::shardOf(int id) const {
+    std::uint32_t h = static_cast<std::uint32_t>(id);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(h) * shardList.size()) >> 32);
+}
+
+// Worker loop: takes the whole inbox at once, applies it outside the lock and publishes.
+void ShardedFleetManager::run(Shard& shard) {
+    std::vector<Command> batch;
+    std::unique_lock<std::mutex> lock(shard.mailboxLock);
+    for (;;) {
+        shard.pending.wait(lock, [&] { return !shard.inbox.empty() || shard.stopping; });
+        if (shard.inbox.empty()) return;
+        batch.swap(shard.inbox);
+        lock.unlock();
+
+        for (const Command& command : batch) apply(shard, command);
+        publish(shard);
+
+        lock.lock();
+        shard.applied += batch.size();
+        batch.clear();
+        shard.drained.notify_all();
+    }
+}
+
+// Applies one command to the shard's fleet, keeping its alert counts current.
+void ShardedFleetManager::apply(Shard& shard, const Command& command) {
+    const TelemetryReading& r = command.reading;
+    const std::size_t slot = shard.fleet.slotOf(r.id);
+    if (slot != VehicleIndex::NPOS) {
+        const FleetColumns& columns = shard.fleet.fleetColumns();
+        shard.overheating -= overheating(columns.temperatures()[slot]);
+        shard.lowFuel -= lowFuel(columns.fuels()[slot]);
+    }
+    if (command.remove) {
+        shard.fleet.removeVehicle(r.id);
+        return;
+    }
+    shard.fleet.upsertReading(r.id, r.speed, r.temperature, r.fuel);
+    shard.overheating += overheating(r.temperature);
+    shard.lowFuel += lowFuel(r.fuel);
+}
+
+void ShardedFleetManager::publish(Shard& shard) {
+    const RunningFleetMoments& moments = shard.fleet.runningMoments();
+    const double count = static_cast<double>(shard.fleet.size());
+    shard.summary.store({shard.fleet.size(), moments.speed.mean * count, moments.temperature.mean * count,
+                         moments.fuel.mean * count, shard.overheating, shard.lowFuel});
+}
+
+void ShardedFleetManager::submit(std::size_t index, const Command* commands, std::size_t count) {
+    Shard& shard = *shardList[index];
+    {
+        std::lock_guard<std::mutex> lock(shard.mailboxLock);
+        shard.inbox.insert(shard.inbox.end(), commands, commands + count);
+        shard.submitted += count;
+    }
+    shard.pending.notify_one();
+}
+
+/**
+ * @brief Queues a reading for the owning shard, which adds the vehicle if it is new.
+ *
+ * Returns as soon as the reading is in the shard's mailbox. Updates from one thread are applied in
+ * the order submitted.
+ */
+void ShardedFleetManager::upsertReading(int id, double speed, double temperature, double fuel) {
+    const Command command{false, {id, speed, temperature, fuel}};
+    submit(shardOf(id), &command, 1);
+}
+
+/**
+ * @brief Queues a batch of readings, taking each shard's mailbox lock once for the whole batch.
+ *
+ * @param readings The readings to apply, in order.
+ * @param count Number of readings.
+ */
+void ShardedFleetManager::upsertReadings(const TelemetryReading* readings, std::size_t count) {
+    std::vector<std::vector<Command>> perShard(shardList.size());
+    for (std::size_t i = 0; i < count; ++i) perShard[shardOf(readings[i].id)].push_back({false, readings[i]});
+    for (std::size_t shard = 0; shard < perShard.size(); ++shard) {
+        if (!perShard[shard].empty()) submit(shard, perShard[shard].data(), perShard[shard].size());
+    }
+}
+
+/**
+ * @brief Queues the removal of a vehicle; unknown ids are ignored.
+ */
+void ShardedFleetManager::removeVehicle(int id) {
+    const Command command{true, {id, 0.0, 0.0, 0.0}};
+    submit(shardOf(id), &command, 1);
+}
+
+/**
+ * @brief Blocks until every update submitted before the call has been applied and published.
+ */
+void ShardedFleetManager::flush() {
+    for (auto& shard : shardList) {
+        std::unique_lock<std::mutex> lock(shard->mailboxLock);
+        const std::uint64_t target = shard->submitted;
+        shard->drained.wait(lock, [&] { return shard->applied >= target; });
+    }
+}
+
+/**
+ * @brief Merges the latest published summary of every shard.
+ *
+ * Each shard summary is read through its seqlock, which never waits for or blocks the shard's
+ * worker; no lock spans more than one shard.
+ */
+ShardSummary ShardedFleetManager::summary() const {
+    ShardSummary total;
+    for (const auto& shard : shardList) total += shard->summary.load();
+    return total;
+}
+
+double ShardedFleetManager::averageSpeed() const {
+    ShardSummary total = summary();
+    return total.vehicles ? total.speedSum / total.vehicles : 0.0;
+}
+
+double ShardedFleetManager::averageTemperature() const {
+    ShardSummary total = summary();
+    return total.vehicles ? total.temperatureSum / total.vehicles : 0.0;
+}
+
+double ShardedFleetManager::averageFuel() const {
+    ShardSummary total = summary();
+    return total.vehicles ? total.fuelSum / total.vehicles : 0.0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ConcurrentIngest.h"
+#include "FleetManager.h"
+#include "Seqlock.h"
+
+// Totals one shard publishes after every batch it applies.
+struct ShardSummary {
+    std::uint64_t vehicles{0};
+    double speedSum{0.0};
+    double temperatureSum{0.0};
+    double fuelSum{0.0};
+    std::uint64_t overheating{0};
+    std::uint64_t lowFuel{0};
+};
+
+// Fleet partitioned by id hash across N shards. Each shard owns a FleetManager,
+// its running averages and alert counts, and a worker thread that applies the
+// updates queued in the shard's mailbox. Callers on any thread submit updates
+// without waiting for them; fleet-wide averages merge the summaries the shards
+// publish through seqlocks, so neither side ever takes a lock spanning shards.
+// Fleet-wide figures are a merge of per-shard states that may be from slightly
+// different moments; flush() makes them reflect every update submitted before it.
+class ShardedFleetManager {
+private:
+    struct Command {
+        bool remove;
+        TelemetryReading reading;
+    };
+
+    struct alignas(64) Shard {
+        FleetManager fleet;
+        std::thread worker;
+        std::mutex mailboxLock;
+        std::condition_variable pending;
+        std::condition_variable drained;
+        std::vector<Command> inbox;
+        std::uint64_t submitted{0};  // Commands queued so far; guarded by mailboxLock
+        std::uint64_t applied{0};    // Commands applied and published; guarded by mailboxLock
+        bool stopping{false};
+        std::uint64_t overheating{0};  // Worker-owned alert state
+        std::uint64_t lowFuel{0};
+        Seqlock<ShardSummary> summary;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shardList;
+
+    void startWorkers();
+    static void run(Shard& shard);
+    static void apply(Shard& shard, const Command& command);
+    static void publish(Shard& shard);
+    void submit(std::size_t shard, const Command* commands, std::size_t count);
+
+public:
+    explicit ShardedFleetManager(std::size_t shards = 0);  // 0 = hardware concurrency
+    ShardedFleetManager(const FleetColumns& fleet, std::size_t shards = 0);
+    ~ShardedFleetManager();
+
+    ShardedFleetManager(const ShardedFleetManager&) = delete;
+    ShardedFleetManager& operator=(const ShardedFleetManager&) = delete;
+
+    std::size_t shards() const { return shardList.size(); }
+    std::size_t shardOf(int id) const;
+
+    void upsertReading(int id, double speed, double temperature, double fuel);
+    void upsertReadings(const TelemetryReading* readings, std::size_t count);  // One mailbox lock per shard
+    void removeVehicle(int id);
+    void flush();  // Waits until every earlier update is applied and published
+
+    ShardSummary shardSummary(std::size_t shard) const { return shardList.at(shard)->summary.load(); }
+    ShardSummary summary() const;  // Merged over all shards
+    std::size_t size() const { return static_cast<std::size_t>(summary().vehicles); }
+    double averageSpeed() const;
+    double averageTemperature() const;
+    double averageFuel() const;
+};
@@ -0,0 +1,222 @@
+#include "SimdKernels.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FLEET_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    using Kernels = simd::KernelSet;
+
+    // ---- Portable fallback -------------------------------------------------
+
+    double sumScalar(const double* values, std::size_t count) {
+        // Four independent accumulators so the loop is not bound by add latency.
+        double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            a += values[i];
+            b += values[i + 1];
+            c += values[i + 2];
+            d += values[i + 3];
+        }
+        for (; i < count; ++i) a += values[i];
+        return (a + b) + (c + d);
+    }
+
+    template<typename Compare>
+    void maskScalarFrom(const double* values, std::size_t first, std::size_t count, double threshold,
+                        std::uint64_t* mask, Compare compare) {
+        for (std::size_t i = first; i < count; ++i) {
+            std::uint64_t bit = compare(values[i], threshold) ? 1 : 0;
+            mask[i / 64] |= bit << (i % 64);
+        }
+    }
+
+    void clearMask(std::size_t count, std::uint64_t* mask) {
+        for (std::size_t w = 0; w < simd::maskWords(count); ++w) mask[w] = 0;
+    }
+
+    struct Greater { bool operator()(double v, double t) const { return v > t; } };
+    struct Less { bool operator()(double v, double t) const { return v < t; } };
+
+    void maskGreaterScalar(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        clearMask(count, mask);
+        maskScalarFrom(values, 0, count, threshold, mask, Greater());
+    }
+
+    void maskLessScalar(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        clearMask(count, mask);
+        maskScalarFrom(values, 0, count, threshold, mask, Less());
+    }
+
+#ifdef FLEET_SIMD_X86
+    // ---- SSE2 --------------------------------------------------------------
+
+    __attribute__((target("sse2")))
+    double sumSse2(const double* values, std::size_t count) {
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            acc0 = _mm_add_pd(acc0, _mm_loadu_pd(values + i));
+            acc1 = _mm_add_pd(acc1, _mm_loadu_pd(values + i + 2));
+            acc2 = _mm_add_pd(acc2, _mm_loadu_pd(values + i + 4));
+            acc3 = _mm_add_pd(acc3, _mm_loadu_pd(values + i + 6));
+        }
+        __m128d acc = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        double total = lanes[0] + lanes[1];
+        for (; i < count; ++i) total += values[i];
+        return total;
+    }
+
+    template<int Predicate, typename Compare>
+    __attribute__((target("sse2")))
+    void maskSse2(const double* values, std::size_t count, double threshold, std::uint64_t* mask, Compare compare) {
+        const __m128d limit = _mm_set1_pd(threshold);
+        std::size_t full = count / 64;
+        for (std::size_t w = 0; w < full; ++w) {
+            const double* block = values + w * 64;
+            std::uint64_t word = 0;
+            for (int j = 0; j < 64; j += 2) {
+                __m128d v = _mm_loadu_pd(block + j);
+                __m128d hit = Predicate == 0 ? _mm_cmpgt_pd(v, limit) : _mm_cmplt_pd(v, limit);
+                word |= static_cast<std::uint64_t>(_mm_movemask_pd(hit)) << j;
+            }
+            mask[w] = word;
+        }
+        if (full * 64 < count) {
+            mask[full] = 0;
+            maskScalarFrom(values, full * 64, count, threshold, mask, compare);
+        }
+    }
+
+    void maskGreaterSse2(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        maskSse2<0>(values, count, threshold, mask, Greater());
+    }
+
+    void maskLessSse2(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        maskSse2<1>(values, count, threshold, mask, Less());
+    }
+
+    // ---- AVX2 --------------------------------------------------------------
+
+    __attribute__((target("avx2")))
+    double sumAvx2(const double* values, std::size_t count) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+            acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+            acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(values + i + 8));
+            acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(values + i + 12));
+        }
+        __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        double lanes[2];
+        _mm_storeu_pd(lanes, half);
+        double total = lanes[0] + lanes[1];
+        for (; i < count; ++i) total += values[i];
+        return total;
+    }
+
+    template<int Predicate, typename Compare>
+    __attribute__((target("avx2")))
+    void maskAvx2(const double* values, std::size_t count, double threshold, std::uint64_t* mask, Compare compare) {
+        const __m256d limit = _mm256_set1_pd(threshold);
+        std::size_t full = count / 64;
+        for (std::size_t w = 0; w < full; ++w) {
+            const double* block = values + w * 64;
+            std::uint64_t word = 0;
+            for (int j = 0; j < 64; j += 4) {
+                __m256d v = _mm256_loadu_pd(block + j);
+                __m256d hit = _mm256_cmp_pd(v, limit, Predicate == 0 ? _CMP_GT_OQ : _CMP_LT_OQ);
+                word |= static_cast<std::uint64_t>(_mm256_movemask_pd(hit)) << j;
+            }
+            mask[w] = word;
+        }
+        if (full * 64 < count) {
+            mask[full] = 0;
+            maskScalarFrom(values, full * 64, count, threshold, mask, compare);
+        }
+    }
+
+    void maskGreaterAvx2(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        maskAvx2<0>(values, count, threshold, mask, Greater());
+    }
+
+    void maskLessAvx2(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+        maskAvx2<1>(values, count, threshold, mask, Less());
+    }
+#endif
+
+    std::vector<Kernels> detectKernels() {
+        std::vector<Kernels> supported;
+#ifdef FLEET_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            supported.push_back({sumAvx2, maskGreaterAvx2, maskLessAvx2, "avx2"});
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            supported.push_back({sumSse2, maskGreaterSse2, maskLessSse2, "sse2"});
+        }
+#endif
+        supported.push_back({sumScalar, maskGreaterScalar, maskLessScalar, "scalar"});
+        return supported;
+    }
+
+    const Kernels& kernels() {
+        static const Kernels selected = simd::supportedKernels().front();
+        return selected;
+    }
+}
+
+/**
+ * @brief Sums a contiguous column of doubles with the best kernel available on this CPU.
+ *
+ * @param values Pointer to the first element of the column.
+ * @param count Number of elements to sum.
+ * @return The sum of the elements, or 0.0 if count is zero.
+ */
+double simd::sum(const double* values, std::size_t count) {
+    return kernels().sum(values, count);
+}
+
+/**
+ * @brief Builds a bitmask of the slots whose value is strictly greater than a threshold.
+ *
+ * Full 64-slot words are produced by vector compares and movemask; the trailing partial word,
+ * if any, is finished with the scalar comparison. NaN values never set a bit.
+ *
+ * @param values Pointer to the first element of the column.
+ * @param count Number of elements to test.
+ * @param threshold Value to compare against.
+ * @param mask Output array of at least maskWords(count) words.
+ */
+void simd::maskGreater(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+    kernels().maskGreater(values, count, threshold, mask);
+}
+
+/**
+ * @brief Builds a bitmask of the slots whose value is strictly less than a threshold.
+ *
+ * @param values Pointer to the first element of the column.
+ * @param count Number of elements to test.
+ * @param threshold Value to compare against.
+ * @param mask Output array of at least maskWords(count) words.
+ */
+void simd::maskLess(const double* values, std::size_t count, double threshold, std::uint64_t* mask) {
+    kernels().maskLess(values, count, threshold, mask);
+}
+
+const char* simd::activeIsa() {
+    return kernels().isa;
+}
+
+const std::vector<simd::KernelSet>& simd::supportedKernels() {
+    static const std::vector<KernelSet> supported = detectKernels();
+    return supported;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Vectorized kernels over contiguous metric columns. The implementation is chosen
+// once at start-up: AVX2 or SSE2 on x86 when the CPU supports it, otherwise a
+// portable scalar loop. All paths produce the same masks; sums may differ from a
+// sequential sum in the last bits because lanes are added in a different order.
+namespace simd {
+    // Number of 64-bit mask words needed for `count` slots.
+    inline std::size_t maskWords(std::size_t count) { return (count + 63) / 64; }
+
+    // Index of the lowest set bit of a non-zero mask word.
+    inline int lowestBit(std::uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    double sum(const double* values, std::size_t count);
+
+    // Sets bit i of `mask` (bit i % 64 of word i / 64) when values[i] > threshold,
+    // or values[i] < threshold for maskLess. Writes maskWords(count) words; bits
+    // past `count` are cleared.
+    void maskGreater(const double* values, std::size_t count, double threshold, std::uint64_t* mask);
+    void maskLess(const double* values, std::size_t count, double threshold, std::uint64_t* mask);
+
+    // Name of the instruction set selected at runtime ("avx2", "sse2" or "scalar").
+    const char* activeIsa();
+
+    // One implementation of the kernels above, for a single instruction set.
+    struct KernelSet {
+        double (*sum)(const double*, std::size_t);
+        void (*maskGreater)(const double*, std::size_t, double, std::uint64_t*);
+        void (*maskLess)(const double*, std::size_t, double, std::uint64_t*);
+        const char* isa;
+    };
+
+    // Every kernel set this CPU can run, best first; the first one is the one in use.
+    // Lets tests and benchmarks exercise the paths the dispatcher would not pick.
+    const std::vector<KernelSet>& supportedKernels();
+}
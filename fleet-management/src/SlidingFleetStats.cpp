@@ -0,0 +1,85 @@
+#include "SlidingFleetStats.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Creates an empty set of windows.
+ *
+ * @param bucketWidth Time covered by one bucket; window boundaries are rounded to it.
+ * @param span Longest window that can be queried; rounded up to whole buckets.
+ *
+ * @throws std::invalid_argument If either duration is not positive.
+ */
+SlidingFleetStats::SlidingFleetStats(Duration bucketWidth, Duration span) : width(bucketWidth) {
+    if (bucketWidth.count() <= 0 || span.count() <= 0) {
+        throw std::invalid_argument("Window bucket width and span must be positive");
+    }
+    buckets.resize(static_cast<std::size_t>((span.count() + width.count() - 1) / width.count()));
+}
+
+SlidingFleetStats::Duration SlidingFleetStats::now() {
+    return std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+/**
+ * @brief Adds one reading received at `time` to its bucket.
+ *
+ * A bucket left over from an earlier revolution of the ring is reset when its slot is reused.
+ * Readings may arrive out of order; one older than the whole span is counted in dropped() and
+ * otherwise ignored.
+ *
+ * @param time When the reading was received.
+ * @param speed, temperature, fuel The reading.
+ */
+void SlidingFleetStats::record(Duration time, double speed, double temperature, double fuel) {
+    const std::int64_t index = time.count() / width.count();
+    const auto ringSize = static_cast<std::int64_t>(buckets.size());
+    if (index <= newestIndex - ringSize) {
+        ++lateReadings;
+        return;
+    }
+    newestIndex = std::max(newestIndex, index);
+
+    Bucket& bucket = buckets[static_cast<std::size_t>(index % ringSize)];
+    if (bucket.index != index) {
+        bucket.index = index;
+        bucket.stats = FleetStats();
+    }
+    bucket.stats.speed.add(speed);
+    bucket.stats.temperature.add(temperature);
+    bucket.stats.fuel.add(fuel);
+}
+
+/**
+ * @brief Returns the statistics of the readings received during the `window` before `now`.
+ *
+ * Merges the bucket containing `now` and the ones before it until `window` is covered, i.e.
+ * window / bucketWidth buckets rounded up. The window therefore always includes the current, partly
+ * filled bucket and may start up to one bucket width later than `now - window`.
+ *
+ * @param now End of the window, normally the current time.
+ * @param window Length of the window; clamped to span().
+ * @return Count, mean, variance, min and max of each metric; counts are zero if nothing arrived.
+ */
+FleetStats SlidingFleetStats::query(Duration now, Duration window) const {
+    const std::int64_t last = now.count() / width.count();
+    const std::int64_t wanted = std::max<std::int64_t>(1, (window.count() + width.count() - 1) / width.count());
+    const auto ringSize = static_cast<std::int64_t>(buckets.size());
+
+    FleetStats stats;
+    for (std::int64_t index = std::max<std::int64_t>(0, last - std::min(wanted, ringSize) + 1); index <= last;
+         ++index) {
+        const Bucket& bucket = buckets[static_cast<std::size_t>(index % ringSize)];
+        if (bucket.index == index) stats.merge(bucket.stats);
+    }
+    return stats;
+}
+
+/**
+ * @brief Discards every recorded reading.
+ */
+void SlidingFleetStats::clear() {
+    std::fill(buckets.begin(), buckets.end(), Bucket());
+    newestIndex = -1;
+    lateReadings = 0;
+}
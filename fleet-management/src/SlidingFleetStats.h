@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FleetStats.h"
+
+// Fleet-wide statistics of the readings received over a trailing time window
+// (e.g. the last minute, five minutes or hour). Readings are pre-aggregated into
+// fixed-width time buckets kept in a ring that spans the longest window, so
+// recording one costs O(1) and a query merges at most window / bucketWidth
+// buckets, however many readings arrived. Times are non-negative offsets from
+// any fixed epoch, typically SlidingFleetStats::now().
+class SlidingFleetStats {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    static constexpr Duration DEFAULT_BUCKET_WIDTH = std::chrono::seconds(5);
+    static constexpr Duration DEFAULT_SPAN = std::chrono::hours(1);
+
+private:
+    struct Bucket {
+        std::int64_t index{-1};  // time / width of the readings aggregated here; -1 if unused
+        FleetStats stats;
+    };
+
+    Duration width;
+    std::vector<Bucket> buckets;
+    std::int64_t newestIndex{-1};
+    std::size_t lateReadings{0};
+
+public:
+    explicit SlidingFleetStats(Duration bucketWidth = DEFAULT_BUCKET_WIDTH, Duration span = DEFAULT_SPAN);
+
+    static Duration now();  // steady_clock time as a Duration
+
+    Duration bucketWidth() const { return width; }
+    Duration span() const { return width * static_cast<std::int64_t>(buckets.size()); }
+
+    void record(Duration time, double speed, double temperature, double fuel);
+    FleetStats query(Duration now, Duration window) const;
+    void clear();
+
+    std::size_t dropped() const { return lateReadings; }  // Readings older than the span on arrival
+};
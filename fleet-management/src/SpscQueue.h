@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Each side owns one index and only reads the other's when its cached
+// copy says the queue looks full (producer) or empty (consumer), and the two
+// sides live on separate cache lines, so a push touches the consumer's line only
+// when the queue looks full and a drain reads the producer's line once per batch.
+template<typename T>
+class SpscQueue {
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    std::size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head{0};  // Next slot to pop; written by the consumer
+    std::size_t cachedTail{0};                              // Consumer's last view of tail
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};  // Next slot to fill; written by the producer
+    std::size_t cachedHead{0};                              // Producer's last view of head
+
+public:
+    // `capacity` is rounded up to a power of two.
+    explicit SpscQueue(std::size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("Queue capacity must be positive");
+        std::size_t size = 1;
+        while (size < capacity) size *= 2;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return slots.size(); }
+
+    // Producer side. Returns false, without blocking, if the queue is full.
+    bool tryPush(const T& value) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == slots.size()) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == slots.size()) return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Passes up to `limit` queued items to `consume` in FIFO order
+    // and frees their slots in one store; returns how many were consumed.
+    template<typename Consume>
+    std::size_t drain(Consume&& consume, std::size_t limit) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (cachedTail - h < limit) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return 0;
+        }
+        const std::size_t n = std::min(limit, cachedTail - h);
+        for (std::size_t i = 0; i < n; ++i) consume(slots[(h + i) & mask]);
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate from either side; exact once both threads are quiescent.
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
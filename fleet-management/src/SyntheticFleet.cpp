@@ -0,0 +1,263 @@
+#include "SyntheticFleet.h"
+#include "AlertEngine.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Upper bound on one formatted row: an int and three shortest-form doubles.
+    constexpr std::size_t MAX_ROW = 128;
+
+    // Alerting readings are kept one CSV digit clear of the thresholds, so truncating to two
+    // decimals never moves a vehicle across one.
+    constexpr double CSV_RESOLUTION = 0.01;
+
+    // Two decimal places, like the sample data; shortest round-trip formatting of the rounded value.
+    char* appendReading(char* out, char* end, double value) {
+        return std::to_chars(out, end, static_cast<double>(static_cast<long long>(value * 100)) / 100).ptr;
+    }
+
+    std::uint64_t splitMix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    class ReadingSampler {
+    private:
+        std::mt19937_64 rng;
+        std::normal_distribution<double> gaussian;
+
+    public:
+        explicit ReadingSampler(std::uint64_t seed) : rng(seed) {}
+
+        double unit() { return static_cast<double>(rng() >> 11) * 0x1.0p-53; }
+        bool chance(double probability) { return unit() < probability; }
+
+        double draw(const ReadingDistribution& d) {
+            if (d.shape == ReadingDistribution::Shape::Uniform) return d.min + (d.max - d.min) * unit();
+            return std::clamp(d.mean + d.stddev * gaussian(rng), d.min, d.max);
+        }
+
+        // Draws from `d` restricted to [lo, hi], falling back to a uniform draw over the interval
+        // when the distribution seldom lands in it.
+        double drawWithin(const ReadingDistribution& d, double lo, double hi) {
+            lo = std::max(lo, d.min);
+            hi = std::min(hi, d.max);
+            for (int attempt = 0; attempt < 16; ++attempt) {
+                double value = draw(d);
+                if (value >= lo && value <= hi) return value;
+            }
+            return lo + (hi - lo) * unit();
+        }
+    };
+
+    void validate(const ReadingDistribution& d, const char* name) {
+        if (!std::isfinite(d.min) || !std::isfinite(d.max) || !(d.min < d.max)) {
+            throw std::invalid_argument(std::string("Invalid ") + name + " range");
+        }
+        if (d.shape == ReadingDistribution::Shape::Normal && !(d.stddev > 0 && std::isfinite(d.mean))) {
+            throw std::invalid_argument(std::string("Invalid ") + name + " distribution");
+        }
+    }
+
+    void validate(const SyntheticFleetProfile& profile) {
+        validate(profile.speed, "speed");
+        validate(profile.temperature, "temperature");
+        validate(profile.fuel, "fuel");
+        if (profile.overheatingRate > 1 || profile.lowFuelRate > 1) {
+            throw std::invalid_argument("Alert rates must not exceed 1");
+        }
+        const double hot = AlertThresholds::CRITICAL_TEMP + CSV_RESOLUTION;
+        const double low = AlertThresholds::LOW_FUEL_THRESHOLD - CSV_RESOLUTION;
+        if ((profile.overheatingRate > 0 && profile.temperature.max <= hot)
+            || (profile.overheatingRate >= 0 && profile.overheatingRate < 1
+                && profile.temperature.min > AlertThresholds::CRITICAL_TEMP)) {
+            throw std::invalid_argument("Temperature range cannot produce the requested overheating rate");
+        }
+        if ((profile.lowFuelRate > 0 && profile.fuel.min >= low)
+            || (profile.lowFuelRate >= 0 && profile.lowFuelRate < 1
+                && profile.fuel.max < AlertThresholds::LOW_FUEL_THRESHOLD)) {
+            throw std::invalid_argument("Fuel range cannot produce the requested low fuel rate");
+        }
+    }
+}
+
+/**
+ * @brief Generates a reproducible fleet of the requested size with the default profile.
+ *
+ * Speeds are drawn from [0, 140) km/h, temperatures from [60, 130) °C and fuel levels from
+ * [0, 100) %, so roughly 29% of vehicles overheat and 15% are low on fuel.
+ *
+ * @param size Number of vehicles to generate.
+ * @param seed Seed for the pseudo-random generator; equal seeds give equal fleets.
+ * @return The generated fleet in columnar form.
+ */
+FleetColumns generateSyntheticFleet(std::size_t size, std::uint64_t seed) {
+    return generateSyntheticFleet(SyntheticFleetProfile(), size, seed);
+}
+
+/**
+ * @brief Generates a reproducible fleet following `profile`, in parallel for large sizes.
+ *
+ * The fleet is split into block-aligned row ranges, one per worker; since every block draws from
+ * its own generator, the result depends only on the profile, size and seed.
+ *
+ * @param profile Reading distributions and alert rates.
+ * @param size Number of vehicles to generate.
+ * @param seed Seed for the pseudo-random generators; equal seeds give equal fleets.
+ * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency().
+ * @return The generated fleet in columnar form.
+ *
+ * @throws std::invalid_argument If the profile is inconsistent.
+ * @throws std::length_error If the ids would not fit in an int.
+ */
+FleetColumns generateSyntheticFleet(const SyntheticFleetProfile& profile, std::size_t size, std::uint64_t seed,
+                                    unsigned threads) {
+    std::vector<int> ids(size);
+    std::vector<double> speeds(size), temperatures(size), fuels(size);
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t blocks = (size + SYNTHETIC_BLOCK_ROWS - 1) / SYNTHETIC_BLOCK_ROWS;
+    std::size_t workers = std::max<std::size_t>(1, std::min<std::size_t>(threads, blocks));
+    auto bound = [&](std::size_t i) { return std::min(size, blocks * i / workers * SYNTHETIC_BLOCK_ROWS); };
+    auto generateRange = [&](std::size_t first, std::size_t last) {
+        generateSyntheticRows(profile, seed, first, last - first, ids.data() + first, speeds.data() + first,
+                              temperatures.data() + first, fuels.data() + first);
+    };
+
+    // The calling thread generates the first range itself.
+    std::vector<std::future<void>> pending;
+    for (std::size_t i = 1; i < workers; ++i) {
+        pending.push_back(std::async(std::launch::async, generateRange, bound(i), bound(i + 1)));
+    }
+    generateRange(bound(0), bound(1));
+    for (auto& part : pending) part.get();
+
+    return FleetColumns(std::move(ids), std::move(speeds), std::move(temperatures), std::move(fuels));
+}
+
+/**
+ * @brief Generates one block-aligned range of a synthetic fleet into caller-owned arrays.
+ *
+ * Row i gets id i + 1. When an alert rate is set, each vehicle first decides whether it alerts
+ * and then draws its reading from the distribution restricted to the matching side of the
+ * threshold, keeping the overall shape of the distribution where possible.
+ *
+ * @param profile Reading distributions and alert rates.
+ * @param seed Seed of the whole fleet.
+ * @param first Index of the first row; must be a multiple of SYNTHETIC_BLOCK_ROWS.
+ * @param count Number of rows to generate.
+ * @param ids, speeds, temperatures, fuels Destination arrays of at least `count` elements.
+ *
+ * @throws std::invalid_argument If `first` is not block-aligned or the profile is inconsistent.
+ * @throws std::length_error If the ids would not fit in an int.
+ */
+void generateSyntheticRows(const SyntheticFleetProfile& profile, std::uint64_t seed, std::size_t first,
+                           std::size_t count, int* ids, double* speeds, double* temperatures, double* fuels) {
+    if (first % SYNTHETIC_BLOCK_ROWS != 0) {
+        throw std::invalid_argument("Synthetic rows must start on a block boundary");
+    }
+    if (count > static_cast<std::size_t>(INT_MAX) || first > static_cast<std::size_t>(INT_MAX) - count) {
+        throw std::length_error("Synthetic fleet ids exceed the int range");
+    }
+    validate(profile);
+
+    const double hot = AlertThresholds::CRITICAL_TEMP + CSV_RESOLUTION;
+    const double low = AlertThresholds::LOW_FUEL_THRESHOLD - CSV_RESOLUTION;
+    for (std::size_t done = 0; done < count;) {
+        const std::size_t row = first + done;
+        const std::size_t rows = std::min(SYNTHETIC_BLOCK_ROWS, count - done);
+        ReadingSampler sampler(splitMix(seed ^ splitMix(row / SYNTHETIC_BLOCK_ROWS)));
+        for (std::size_t i = done; i < done + rows; ++i) {
+            ids[i] = static_cast<int>(first + i + 1);
+            speeds[i] = sampler.draw(profile.speed);
+
+            if (profile.overheatingRate < 0) {
+                temperatures[i] = sampler.draw(profile.temperature);
+            } else if (sampler.chance(profile.overheatingRate)) {
+                temperatures[i] = sampler.drawWithin(profile.temperature, hot, profile.temperature.max);
+            } else {
+                temperatures[i] = sampler.drawWithin(profile.temperature, profile.temperature.min,
+                                                     AlertThresholds::CRITICAL_TEMP);
+            }
+
+            if (profile.lowFuelRate < 0) {
+                fuels[i] = sampler.draw(profile.fuel);
+            } else if (sampler.chance(profile.lowFuelRate)) {
+                fuels[i] = sampler.drawWithin(profile.fuel, profile.fuel.min, low);
+            } else {
+                fuels[i] = sampler.drawWithin(profile.fuel, AlertThresholds::LOW_FUEL_THRESHOLD, profile.fuel.max);
+            }
+        }
+        done += rows;
+    }
+}
+
+/**
+ * @brief Formats rows in CSV layout with readings rounded to two decimals.
+ *
+ * Each row is formatted with std::to_chars on the stack and appended, so `out` grows by
+ * exactly the formatted size.
+ */
+void appendFleetCsvRows(const int* ids, const double* speeds, const double* temperatures, const double* fuels,
+                        std::size_t count, std::string& out) {
+    char row[MAX_ROW];
+    char* const end = row + MAX_ROW;
+    for (std::size_t i = 0; i < count; ++i) {
+        char* cursor = std::to_chars(row, end, ids[i]).ptr;
+        *cursor++ = ',';
+        cursor = appendReading(cursor, end, speeds[i]);
+        *cursor++ = ',';
+        cursor = appendReading(cursor, end, temperatures[i]);
+        *cursor++ = ',';
+        cursor = appendReading(cursor, end, fuels[i]);
+        *cursor++ = '\n';
+        out.append(row, cursor);
+    }
+}
+
+/**
+ * @brief Writes a fleet as CSV with a header line, readings rounded to two decimals.
+ *
+ * Rows are formatted in batches into one reused buffer that is flushed as it fills.
+ *
+ * @param columns The fleet to write.
+ * @param filename Path of the CSV file to create or overwrite.
+ * @return The size of the written file in bytes.
+ *
+ * @throws std::runtime_error If the file cannot be created or written.
+ */
+std::uint64_t writeFleetCsv(const FleetColumns& columns, const std::string& filename) {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Unable to create file: " + filename);
+    }
+
+    constexpr std::size_t BATCH_ROWS = 1 << 14;
+    std::string buffer = "id,speed,temperature,fuel\n";
+    buffer.reserve(BATCH_ROWS * MAX_ROW);
+    std::uint64_t written = 0;
+    for (std::size_t first = 0; first < columns.size() || !buffer.empty(); first += BATCH_ROWS) {
+        std::size_t rows = first < columns.size() ? std::min(BATCH_ROWS, columns.size() - first) : 0;
+        appendFleetCsvRows(columns.ids() + first, columns.speeds() + first, columns.temperatures() + first,
+                           columns.fuels() + first, rows, buffer);
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        written += buffer.size();
+        buffer.clear();
+    }
+
+    if (!out) {
+        throw std::runtime_error("Unable to write file: " + filename);
+    }
+    return written;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "FleetColumns.h"
+
+// Distribution of one synthetic reading. Normal draws are clamped to [min, max].
+struct ReadingDistribution {
+    enum class Shape { Uniform, Normal };
+
+    Shape shape;
+    double min;
+    double max;
+    double mean;
+    double stddev;
+
+    static ReadingDistribution uniform(double min, double max) { return {Shape::Uniform, min, max, 0.0, 0.0}; }
+    static ReadingDistribution normal(double mean, double stddev, double min, double max) {
+        return {Shape::Normal, min, max, mean, stddev};
+    }
+};
+
+// Shape of a synthetic fleet. A negative alert rate leaves the share of alerting
+// vehicles to the distribution; a rate in [0, 1] forces that share of vehicles
+// above CRITICAL_TEMP or below LOW_FUEL_THRESHOLD.
+struct SyntheticFleetProfile {
+    ReadingDistribution speed = ReadingDistribution::uniform(0.0, 140.0);
+    ReadingDistribution temperature = ReadingDistribution::uniform(60.0, 130.0);
+    ReadingDistribution fuel = ReadingDistribution::uniform(0.0, 100.0);
+    double overheatingRate = -1.0;
+    double lowFuelRate = -1.0;
+};
+
+// Rows are generated in blocks of this many, each from its own seeded generator,
+// so a fleet is identical however it is split across threads.
+constexpr std::size_t SYNTHETIC_BLOCK_ROWS = 4096;
+
+// Deterministic synthetic fleets for benchmarks and load tests. Ids run from 1
+// to `size`; readings are uniformly distributed over plausible ranges.
+FleetColumns generateSyntheticFleet(std::size_t size, std::uint64_t seed = 42);
+FleetColumns generateSyntheticFleet(const SyntheticFleetProfile& profile, std::size_t size, std::uint64_t seed = 42,
+                                    unsigned threads = 0);
+
+// Generates rows [first, first + count) of a fleet into caller-owned arrays. `first`
+// must be a multiple of SYNTHETIC_BLOCK_ROWS.
+void generateSyntheticRows(const SyntheticFleetProfile& profile, std::uint64_t seed, std::size_t first,
+                           std::size_t count, int* ids, double* speeds, double* temperatures, double* fuels);
+
+// Appends rows in the `id,speed,temperature,fuel` CSV layout (no header) to `out`.
+void appendFleetCsvRows(const int* ids, const double* speeds, const double* temperatures, const double* fuels,
+                        std::size_t count, std::string& out);
+
+// Writes columns in the `id,speed,temperature,fuel` CSV layout of data/vehicles.csv.
+// Returns the number of bytes written.
+std::uint64_t writeFleetCsv(const FleetColumns& columns, const std::string& filename);
@@ -0,0 +1,132 @@
+#include "TaskPool.h"
+#include <algorithm>
+
+namespace {
+    // Pool and deque index of the calling thread if it is a pool worker.
+    thread_local const TaskPool* currentPool = nullptr;
+    thread_local std::size_t currentIndex = 0;
+}
+
+/**
+ * @brief Starts the worker threads, each with its own task deque.
+ *
+ * @param threads Number of workers; 0 uses std::thread::hardware_concurrency().
+ */
+TaskPool::TaskPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i) queues.push_back(std::make_unique<WorkerQueue>());
+    for (unsigned i = 0; i < threads; ++i) this->threads.emplace_back(&TaskPool::workerLoop, this, i);
+}
+
+/**
+ * @brief Runs every task still queued, then stops and joins the workers.
+ */
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+// Workers push to their own deque; other threads spread their tasks round-robin.
+std::size_t TaskPool::homeQueue() {
+    if (currentPool == this) return currentIndex;
+    return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+}
+
+/**
+ * @brief Queues a task as part of `group`.
+ *
+ * @param group The job the task belongs to; must outlive the task.
+ * @param task The work to run on some pool thread (or on a thread waiting on any group).
+ */
+void TaskPool::submit(TaskGroup& group, Task task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    WorkerQueue& queue = *queues[homeQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back({std::move(task), &group});
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // Taking the sleep lock orders this push before any worker's decision to sleep.
+    { std::lock_guard<std::mutex> lock(sleepLock); }
+    wake.notify_one();
+}
+
+void TaskPool::execute(Entry& entry) {
+    try {
+        entry.task();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(entry.group->errorLock);
+        if (!entry.group->error) entry.group->error = std::current_exception();
+    }
+    entry.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Runs one queued task: the newest from the home deque, else the oldest from another.
+ *
+ * @return false if every deque was empty.
+ */
+bool TaskPool::runOne(std::size_t home) {
+    Entry entry;
+    bool found = false;
+    {
+        WorkerQueue& own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.tasks.empty()) {
+            entry = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (std::size_t i = 1; !found && i < queues.size(); ++i) {
+        WorkerQueue& victim = *queues[(home + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            entry = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    execute(entry);
+    return true;
+}
+
+void TaskPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    for (;;) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [&] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+/**
+ * @brief Waits until every task of `group` has finished, running queued tasks meanwhile.
+ *
+ * The waiting thread works instead of sleeping, so waiting inside a task (e.g. a job that splits
+ * its scan with parallelFor) cannot starve the pool of threads.
+ *
+ * @param group The job to wait for.
+ *
+ * @throws Any exception thrown by one of the group's tasks, after all of them have finished.
+ */
+void TaskPool::wait(TaskGroup& group) {
+    const std::size_t home = currentPool == this ? currentIndex : 0;
+    while (!group.done()) {
+        if (!runOne(home)) std::this_thread::yield();
+    }
+    if (group.error) {
+        std::exception_ptr error = group.error;
+        group.error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
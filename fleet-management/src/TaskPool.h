@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tasks of one job still to finish; TaskPool::wait returns once they all have.
+class TaskGroup {
+private:
+    friend class TaskPool;
+    std::atomic<std::size_t> pending{0};
+    std::mutex errorLock;
+    std::exception_ptr error;  // First exception thrown by a task of the group
+
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Work-stealing thread pool for fleet analyses. Every worker owns a deque: it
+// pushes and pops its own tasks at the back (most recent, still in cache) while
+// idle workers steal from the front of others' deques (oldest, usually the
+// largest remaining piece of work). Waiting threads run queued tasks instead of
+// blocking, so a task may itself split its scan with parallelFor and wait.
+class TaskPool {
+public:
+    using Task = std::function<void()>;
+
+    // Vehicles per scan chunk: 8192 slots of three 8-byte metrics is 192 KiB, an
+    // L2-sized working set; a multiple of 64 so alert mask words are never shared.
+    static constexpr std::size_t FLEET_CHUNK = 8192;
+
+private:
+    struct Entry {
+        Task task;
+        TaskGroup* group;
+    };
+
+    struct alignas(64) WorkerQueue {
+        std::mutex lock;
+        std::deque<Entry> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> nextQueue{0};  // Round-robin target for tasks submitted from outside
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping{false};
+
+    std::size_t homeQueue();
+    bool runOne(std::size_t home);
+    void workerLoop(std::size_t index);
+    static void execute(Entry& entry);
+
+public:
+    explicit TaskPool(unsigned threads = 0);  // 0 = hardware concurrency
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    std::size_t workers() const { return threads.size(); }
+
+    void submit(TaskGroup& group, Task task);
+    void wait(TaskGroup& group);  // Rethrows the first exception of the group's tasks
+
+    // Runs body(first, last) over [0, count) in chunks of `grain` and waits for all of them.
+    template<typename Body>
+    void parallelFor(std::size_t count, std::size_t grain, const Body& body);
+};
+
+template<typename Body>
+void TaskPool::parallelFor(std::size_t count, std::size_t grain, const Body& body) {
+    if (grain == 0) grain = 1;
+    TaskGroup group;
+    for (std::size_t first = 0; first < count; first += grain) {
+        const std::size_t last = count - first > grain ? first + grain : count;
+        submit(group, [&body, first, last] { body(first, last); });
+    }
+    wait(group);
+}
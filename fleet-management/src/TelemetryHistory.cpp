@@ -0,0 +1,212 @@
+#include "TelemetryHistory.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t MIN_CAPACITY = 8;  // One cache line of doubles
+
+    std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t capacity = MIN_CAPACITY;
+        while (capacity < n) capacity *= 2;
+        return capacity;
+    }
+
+    // Adds `sequence` to the back of a monotonic queue over the last `window` samples. For the
+    // min queue `dominates(a, b)` is a <= b: a newer sample no larger than an older one makes the
+    // older one irrelevant for the rest of its life in the window.
+    template<typename Dominates>
+    void pushMonotonic(std::uint32_t* queue, std::uint32_t window, std::uint32_t& front, std::uint32_t& size,
+                       const double* values, std::size_t mask, std::uint32_t sequence, double value,
+                       Dominates dominates) {
+        while (size && static_cast<std::uint32_t>(sequence - queue[front]) >= window) {
+            front = (front + 1) % window;
+            --size;
+        }
+        while (size && dominates(value, values[queue[(front + size - 1) % window] & mask])) --size;
+        queue[(front + size) % window] = sequence;
+        ++size;
+    }
+}
+
+/**
+ * @brief Creates an empty history.
+ *
+ * @param capacity Samples kept per vehicle; rounded up to a power of two of at least 8.
+ * @param extremaWindow Number of most recent samples covered by min() and max().
+ *
+ * @throws std::invalid_argument If extremaWindow is zero or larger than the capacity.
+ */
+TelemetryHistory::TelemetryHistory(std::size_t capacity, std::size_t extremaWindow)
+    : ringCapacity(roundUpToPowerOfTwo(capacity)), mask(ringCapacity - 1), window(extremaWindow) {
+    if (window == 0 || window > ringCapacity || ringCapacity > (std::size_t(1) << 31)) {
+        throw std::invalid_argument("History extrema window must be between 1 and the capacity");
+    }
+}
+
+/**
+ * @brief Sets the number of slots; new slots start with no samples.
+ */
+void TelemetryHistory::resize(std::size_t slots) {
+    slotCount = slots;
+    appended.resize(slots, 0);
+    for (MetricRings& r : rings) {
+        r.values.resize(slots * ringCapacity);
+        r.prefixSums.resize(slots * ringCapacity);
+        r.evictedSum.resize(slots, 0.0);
+        r.minQueue.resize(slots * window);
+        r.maxQueue.resize(slots * window);
+        r.minState.resize(slots, QueueState{0, 0});
+        r.maxState.resize(slots, QueueState{0, 0});
+    }
+}
+
+void TelemetryHistory::push(MetricRings& r, std::size_t slot, std::uint64_t sequence, double value) {
+    double* values = r.values.data() + slot * ringCapacity;
+    double* prefix = r.prefixSums.data() + slot * ringCapacity;
+    const std::size_t position = sequence & mask;
+
+    if (sequence >= ringCapacity) r.evictedSum[slot] = prefix[position];
+    const double previous = sequence == 0 ? 0.0 : prefix[(sequence - 1) & mask];
+    values[position] = value;
+    prefix[position] = previous + value;
+
+    const auto w = static_cast<std::uint32_t>(window);
+    const auto s = static_cast<std::uint32_t>(sequence);
+    QueueState& low = r.minState[slot];
+    pushMonotonic(r.minQueue.data() + slot * window, w, low.front, low.size, values, mask, s, value,
+                  [](double a, double b) { return a <= b; });
+    QueueState& high = r.maxState[slot];
+    pushMonotonic(r.maxQueue.data() + slot * window, w, high.front, high.size, values, mask, s, value,
+                  [](double a, double b) { return a >= b; });
+}
+
+// Once per ring revolution, shifts the slot's prefix sums so they start from zero again. This keeps
+// their magnitude bounded by one ring's worth of samples, and with it the rounding error of mean(),
+// however long the vehicle has been reporting. Costs O(capacity) every `capacity` appends.
+void TelemetryHistory::rebase(MetricRings& r, std::size_t slot) {
+    const double offset = r.evictedSum[slot];
+    if (offset == 0.0) return;
+    double* prefix = r.prefixSums.data() + slot * ringCapacity;
+    for (std::size_t i = 0; i < ringCapacity; ++i) prefix[i] -= offset;
+    r.evictedSum[slot] = 0.0;
+}
+
+/**
+ * @brief Records one reading of the vehicle in `slot`, evicting its oldest sample when full.
+ *
+ * @param slot Fleet slot of the vehicle; must be below slots().
+ * @param speed, temperature, fuel The reading.
+ */
+void TelemetryHistory::append(std::size_t slot, double speed, double temperature, double fuel) {
+    const std::uint64_t sequence = appended[slot];
+    push(rings[0], slot, sequence, speed);
+    push(rings[1], slot, sequence, temperature);
+    push(rings[2], slot, sequence, fuel);
+    appended[slot] = sequence + 1;
+    if (((sequence + 1) & mask) == 0) {
+        for (MetricRings& r : rings) rebase(r, slot);
+    }
+}
+
+/**
+ * @brief Forgets every sample of the vehicle in `slot`.
+ */
+void TelemetryHistory::clear(std::size_t slot) {
+    appended[slot] = 0;
+    for (MetricRings& r : rings) {
+        r.evictedSum[slot] = 0.0;
+        r.minState[slot] = QueueState{0, 0};
+        r.maxState[slot] = QueueState{0, 0};
+    }
+}
+
+/**
+ * @brief Moves the history of the last slot into `slot` and drops the last slot.
+ *
+ * Call together with FleetColumns::swapRemove so histories stay with their vehicles. Copies one
+ * ring and two queues per metric.
+ */
+void TelemetryHistory::swapRemove(std::size_t slot) {
+    const std::size_t last = slotCount - 1;
+    if (slot != last) {
+        appended[slot] = appended[last];
+        for (MetricRings& r : rings) {
+            std::copy_n(r.values.begin() + last * ringCapacity, ringCapacity, r.values.begin() + slot * ringCapacity);
+            std::copy_n(r.prefixSums.begin() + last * ringCapacity, ringCapacity,
+                        r.prefixSums.begin() + slot * ringCapacity);
+            std::copy_n(r.minQueue.begin() + last * window, window, r.minQueue.begin() + slot * window);
+            std::copy_n(r.maxQueue.begin() + last * window, window, r.maxQueue.begin() + slot * window);
+            r.evictedSum[slot] = r.evictedSum[last];
+            r.minState[slot] = r.minState[last];
+            r.maxState[slot] = r.maxState[last];
+        }
+    }
+    resize(last);
+}
+
+/**
+ * @brief Returns the number of samples currently retained for `slot` (at most capacity()).
+ */
+std::size_t TelemetryHistory::samples(std::size_t slot) const {
+    return static_cast<std::size_t>(std::min<std::uint64_t>(appended[slot], ringCapacity));
+}
+
+/**
+ * @brief Returns one retained sample.
+ *
+ * @param slot Fleet slot of the vehicle.
+ * @param metric The reading to return.
+ * @param age 0 for the newest sample, 1 for the one before, and so on.
+ *
+ * @throws std::out_of_range If fewer than age + 1 samples are retained.
+ */
+double TelemetryHistory::sample(std::size_t slot, Metric metric, std::size_t age) const {
+    if (age >= samples(slot)) {
+        throw std::out_of_range("History sample is older than the retained window");
+    }
+    return metricRings(metric).values[slot * ringCapacity + ((appended[slot] - 1 - age) & mask)];
+}
+
+/**
+ * @brief Returns the mean of the most recent samples in O(1).
+ *
+ * The sum of the window is the difference of two prefix sums, so the cost does not depend on the
+ * window length.
+ *
+ * @param slot Fleet slot of the vehicle.
+ * @param metric The reading to average.
+ * @param lastSamples Window length; clamped to the number of retained samples.
+ * @return The mean, or NaN if the window is empty.
+ */
+double TelemetryHistory::mean(std::size_t slot, Metric metric, std::size_t lastSamples) const {
+    const std::size_t retained = samples(slot);
+    const std::size_t n = std::min(lastSamples, retained);
+    if (n == 0) return std::numeric_limits<double>::quiet_NaN();
+
+    const MetricRings& r = metricRings(metric);
+    const double* prefix = r.prefixSums.data() + slot * ringCapacity;
+    const std::uint64_t newest = appended[slot] - 1;
+    const double before = n == retained ? r.evictedSum[slot] : prefix[(newest - n) & mask];
+    return (prefix[newest & mask] - before) / static_cast<double>(n);
+}
+
+/**
+ * @brief Returns the smallest of the last extremaWindow() samples in O(1), or NaN if there are none.
+ */
+double TelemetryHistory::min(std::size_t slot, Metric metric) const {
+    const MetricRings& r = metricRings(metric);
+    const QueueState& q = r.minState[slot];
+    if (q.size == 0) return std::numeric_limits<double>::quiet_NaN();
+    return r.values[slot * ringCapacity + (r.minQueue[slot * window + q.front] & mask)];
+}
+
+/**
+ * @brief Returns the largest of the last extremaWindow() samples in O(1), or NaN if there are none.
+ */
+double TelemetryHistory::max(std::size_t slot, Metric metric) const {
+    const MetricRings& r = metricRings(metric);
+    const QueueState& q = r.maxState[slot];
+    if (q.size == 0) return std::numeric_limits<double>::quiet_NaN();
+    return r.values[slot * ringCapacity + (r.maxQueue[slot * window + q.front] & mask)];
+}
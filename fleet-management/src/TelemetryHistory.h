@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AlignedAllocator.h"
+#include "FleetColumns.h"
+
+// Fixed-capacity history of every vehicle's readings, indexed by fleet slot.
+// Each metric is its own column of per-slot rings; the capacity is rounded up to
+// a power of two of at least 8 samples, so every ring starts on its own cache line.
+// Appending is O(1). The mean over any number of recent samples is O(1) from
+// prefix sums kept alongside the ring, and the min/max over the last
+// `extremaWindow` samples are O(1) from per-slot monotonic queues.
+class TelemetryHistory {
+private:
+    template<typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    struct QueueState {
+        std::uint32_t front;
+        std::uint32_t size;
+    };
+
+    // Rings of one metric for all slots. Sample number n of a slot lives at
+    // slot * capacity + (n & mask); queues hold sample numbers, slot * window apart.
+    struct MetricRings {
+        AlignedVector<double> values;
+        AlignedVector<double> prefixSums;  // Sum of the slot's samples up to and including this one
+        std::vector<double> evictedSum;    // Prefix sum just before the oldest retained sample
+        AlignedVector<std::uint32_t> minQueue;
+        AlignedVector<std::uint32_t> maxQueue;
+        std::vector<QueueState> minState;
+        std::vector<QueueState> maxState;
+    };
+
+    std::size_t ringCapacity;
+    std::size_t mask;
+    std::size_t window;
+    std::size_t slotCount{0};
+    std::vector<std::uint64_t> appended;  // Samples ever appended, per slot
+    MetricRings rings[3];
+
+    void push(MetricRings& rings, std::size_t slot, std::uint64_t sequence, double value);
+    void rebase(MetricRings& rings, std::size_t slot);
+    const MetricRings& metricRings(Metric metric) const { return rings[static_cast<int>(metric)]; }
+
+public:
+    TelemetryHistory(std::size_t capacity, std::size_t extremaWindow);
+
+    std::size_t capacity() const { return ringCapacity; }
+    std::size_t extremaWindow() const { return window; }
+    std::size_t slots() const { return slotCount; }
+
+    void resize(std::size_t slots);
+    void append(std::size_t slot, double speed, double temperature, double fuel);
+    void clear(std::size_t slot);
+    void swapRemove(std::size_t slot);  // Mirrors FleetColumns::swapRemove
+
+    std::size_t samples(std::size_t slot) const;
+    double sample(std::size_t slot, Metric metric, std::size_t age) const;  // age 0 = newest
+    double mean(std::size_t slot, Metric metric, std::size_t lastSamples) const;
+    double min(std::size_t slot, Metric metric) const;  // Over the extrema window
+    double max(std::size_t slot, Metric metric) const;
+};
@@ -0,0 +1,237 @@
+#include "TelemetryStream.h"
+#include "CsvLoader.h"
+#include "Instrumentation.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    // Bytes requested per read(); also the most input parsed before alerts are flushed.
+    constexpr std::size_t READ_CHUNK = 64 * 1024;
+}
+
+TelemetryStream::TelemetryStream(FleetManager& fleet) : fleet(fleet) {}
+
+/**
+ * @brief Parses one complete line and applies it to the fleet.
+ *
+ * A valid record updates the vehicle in place (or adds it if the id is new), after which that
+ * vehicle alone is checked against its alert state, which reports an alert once when it is raised
+ * and once when it clears (see FleetManager::alertChanges). With configured rules (see useRules)
+ * the reading is checked against those instead, before it replaces the previous one. The first
+ * line of the stream may be a CSV header and is skipped silently if it does not parse; later bad
+ * lines are reported on std::cerr.
+ */
+void TelemetryStream::applyLine(const char* first, const char* last) {
+    bool header = headerAllowed;
+    headerAllowed = false;
+
+    VehicleRecord r;
+    if (!parseVehicleRecord(first, last, r)) {
+        while (first != last && (*first == '\r' || *first == ' ' || *first == '\t')) ++first;
+        if (first == last || header) return;
+        ++parseFailures;
+        std::cerr << "Error parsing line: ";
+        std::cerr.write(first, last - first) << '\n';
+        return;
+    }
+
+    if (rules) {
+        // The reading being replaced is the baseline of the rise/drop rules.
+        const std::size_t slot = fleet.slotOf(r.id);
+        double previous[3];
+        if (slot != VehicleIndex::NPOS) {
+            const FleetColumns& columns = fleet.fleetColumns();
+            previous[0] = columns.speeds()[slot];
+            previous[1] = columns.temperatures()[slot];
+            previous[2] = columns.fuels()[slot];
+        }
+        const double reading[] = {r.speed, r.temperature, r.fuel};
+        const double* baseline = slot != VehicleIndex::NPOS ? previous : nullptr;
+        alerts.append(r.id, rules->evaluate(reading, baseline), rules->rules());
+    }
+    fleet.upsertReading(r.id, r.speed, r.temperature, r.fuel);
+    ++recordsApplied;
+    if (windows) windows->record(receivedAt, r.speed, r.temperature, r.fuel);
+    if (!rules) alerts.appendEdges(r.id, fleet.alertChanges(r.id));
+}
+
+/**
+ * @brief Checks every applied reading against configured rules instead of the built-in alerts.
+ *
+ * Threshold rules report each matching reading; rise/drop rules compare a reading with the same
+ * vehicle's previous one, so they report sudden changes as they arrive. A vehicle's first reading
+ * has no previous one and never matches them.
+ *
+ * @param rules The rule engine; must outlive the stream.
+ *
+ * @throws std::invalid_argument If the engine has more than AlertRuleEngine::MAX_READING_RULES
+ *         rules.
+ */
+void TelemetryStream::useRules(const AlertRuleEngine& rules) {
+    if (rules.rules().size() > AlertRuleEngine::MAX_READING_RULES) {
+        throw std::invalid_argument("Stream mode supports at most " +
+                                    std::to_string(AlertRuleEngine::MAX_READING_RULES) +
+                                    " alert rules");
+    }
+    this->rules = &rules;
+}
+
+/**
+ * @brief Feeds a chunk of raw stream bytes.
+ *
+ * Complete lines are parsed straight from `data`; only a line split across two chunks is copied,
+ * into a small carry-over buffer that is completed by the next call. With trackWindows, every
+ * record in the chunk is timestamped with the time the chunk was received.
+ *
+ * @param data Pointer to the received bytes.
+ * @param length Number of bytes received.
+ */
+void TelemetryStream::consume(const char* data, std::size_t length) {
+    instrumentation::ScopedTimer timer(instrumentation::Stage::Ingest);
+    const std::size_t recordsBefore = recordsApplied;
+    const std::size_t failuresBefore = parseFailures;
+    if (windows) receivedAt = SlidingFleetStats::now();
+    consumeLines(data, length);
+    instrumentation::add(instrumentation::Counter::BytesRead, length);
+    instrumentation::add(instrumentation::Counter::RowsParsed, recordsApplied - recordsBefore);
+    instrumentation::add(instrumentation::Counter::ParseFailures, parseFailures - failuresBefore);
+}
+
+void TelemetryStream::consumeLines(const char* data, std::size_t length) {
+    const char* cursor = data;
+    const char* last = data + length;
+
+    if (!partialLine.empty()) {
+        const char* nl = static_cast<const char*>(std::memchr(cursor, '\n', length));
+        if (nl == nullptr) {
+            partialLine.append(cursor, last);
+            return;
+        }
+        partialLine.append(cursor, nl);
+        applyLine(partialLine.data(), partialLine.data() + partialLine.size());
+        partialLine.clear();
+        cursor = nl + 1;
+    }
+
+    while (cursor != last) {
+        const char* nl = static_cast<const char*>(std::memchr(cursor, '\n', last - cursor));
+        if (nl == nullptr) {
+            partialLine.assign(cursor, last);
+            return;
+        }
+        applyLine(cursor, nl);
+        cursor = nl + 1;
+    }
+}
+
+/**
+ * @brief Applies a final line that was not terminated by '\n' (end of stream).
+ */
+void TelemetryStream::finish() {
+    if (!partialLine.empty()) {
+        if (windows) receivedAt = SlidingFleetStats::now();
+        const std::size_t recordsBefore = recordsApplied;
+        const std::size_t failuresBefore = parseFailures;
+        applyLine(partialLine.data(), partialLine.data() + partialLine.size());
+        partialLine.clear();
+        instrumentation::add(instrumentation::Counter::RowsParsed, recordsApplied - recordsBefore);
+        instrumentation::add(instrumentation::Counter::ParseFailures,
+                             parseFailures - failuresBefore);
+    }
+}
+
+/**
+ * @brief Writes all alerts produced since the last flush and clears them.
+ *
+ * @param fd Destination file descriptor (standard output by default).
+ */
+void TelemetryStream::flush(int fd) {
+    if (alerts.empty()) return;
+    alerts.write(fd);
+    alerts.clear();
+}
+
+/**
+ * @brief Reads records from a file descriptor until end of stream, emitting alerts as it goes.
+ *
+ * Each read() returns at most 64 KiB; the bytes are applied and the alerts they produced are
+ * flushed before the next read blocks. Alert latency is therefore bounded by the time to parse
+ * one chunk rather than by the length of the stream, and an idle producer never holds back alerts
+ * for records it has already sent. Works with pipes, FIFOs, sockets and regular files.
+ *
+ * @param inputFd File descriptor to read records from (e.g. 0 for stdin, or an opened FIFO).
+ * @param outputFd File descriptor to write alerts to.
+ * @return The number of records applied during this call.
+ *
+ * @throws std::runtime_error If reading from the input fails.
+ */
+std::size_t TelemetryStream::run(int inputFd, int outputFd) {
+    std::size_t before = recordsApplied;
+    std::vector<char> chunk(READ_CHUNK);
+    for (;;) {
+#ifdef _WIN32
+        int received = ::_read(inputFd, chunk.data(), static_cast<unsigned>(chunk.size()));
+#else
+        ssize_t received = ::read(inputFd, chunk.data(), chunk.size());
+#endif
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Unable to read telemetry stream");
+        }
+        if (received == 0) break;
+        consume(chunk.data(), static_cast<std::size_t>(received));
+        flush(outputFd);
+    }
+    finish();
+    flush(outputFd);
+    return recordsApplied - before;
+}
+
+/**
+ * @brief Opens a stream source by name and runs it to end of stream.
+ *
+ * @param source Path of a file or FIFO to read, or "-" for standard input.
+ * @param outputFd File descriptor to write alerts to.
+ * @return The number of records applied.
+ *
+ * @throws std::runtime_error If the source cannot be opened or read.
+ */
+std::size_t TelemetryStream::run(const std::string& source, int outputFd) {
+    if (source == "-") return run(0, outputFd);
+
+#ifdef _WIN32
+    int fd = ::_open(source.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    int fd = ::open(source.c_str(), O_RDONLY);
+#endif
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open stream: " + source);
+    }
+    try {
+        std::size_t applied = run(fd, outputFd);
+#ifdef _WIN32
+        ::_close(fd);
+#else
+        ::close(fd);
+#endif
+        return applied;
+    }
+    catch (...) {
+#ifdef _WIN32
+        ::_close(fd);
+#else
+        ::close(fd);
+#endif
+        throw;
+    }
+}
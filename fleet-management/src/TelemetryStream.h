@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "FleetManager.h"
+#include "SlidingFleetStats.h"
+
+// Applies an unbounded stream of `id,speed,temperature,fuel` records to a fleet,
+// buffering the resulting alert transitions until flush(): an alert is written when
+// a vehicle raises it and when it clears, not for every reading. With useRules,
+// each reading is checked against configured rules instead. Unknown ids join the
+// fleet.
+class TelemetryStream {
+private:
+    FleetManager& fleet;
+    AlertReporter alerts;
+    const AlertRuleEngine* rules{nullptr};
+    SlidingFleetStats* windows{nullptr};
+    SlidingFleetStats::Duration receivedAt{0};
+    std::string partialLine;
+    std::size_t recordsApplied{0};
+    std::size_t parseFailures{0};
+    bool headerAllowed{true};
+
+    void applyLine(const char* first, const char* last);
+    void consumeLines(const char* data, std::size_t length);
+
+public:
+    explicit TelemetryStream(FleetManager& fleet);
+
+    // Records every applied reading in the windows
+    void trackWindows(SlidingFleetStats& windows) { this->windows = &windows; }
+    void useRules(const AlertRuleEngine& rules);  // Replaces the built-in edge-triggered alerts
+    void consume(const char* data, std::size_t length);
+    void finish();
+    const std::string& pendingAlerts() const { return alerts.text(); }
+    void flush(int fd = 1);
+    std::size_t run(int inputFd, int outputFd = 1);
+    std::size_t run(const std::string& source, int outputFd = 1);
+
+    std::size_t records() const { return recordsApplied; }
+    std::size_t failures() const { return parseFailures; }
+};
@@ -62,4 +62,20 @@ double Vehicle::getTemperature() const {
  */
 double Vehicle::getFuel() const {
     return fuel;
+}
+
+/**
+ * @brief Replaces the vehicle's telemetry readings with a newer sample.
+ *
+ * The vehicle ID is fixed for the lifetime of the object; only speed, temperature
+ * and fuel level change as new telemetry arrives.
+ *
+ * @param speed New speed of the vehicle.
+ * @param temperature New temperature reading of the vehicle.
+ * @param fuel New fuel level of the vehicle.
+ */
+void Vehicle::updateReading(double speed, double temperature, double fuel) {
+    this->speed = speed;
+    this->temperature = temperature;
+    this->fuel = fuel;
 }
\ No newline at end of file
@@ -15,6 +15,8 @@ public:
     double getSpeed() const;
     double getTemperature() const;
     double getFuel() const;
+
+    void updateReading(double speed, double temperature, double fuel);
 };
 
 #endif // VEHICLE_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "VehicleIndex.h"
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t MIN_CAPACITY = 16;
+}
+
+VehicleIndex::VehicleIndex() { rehash(MIN_CAPACITY); }
+
+/**
+ * @brief Maps an id to its preferred table position with Fibonacci hashing.
+ *
+ * Multiplying by 2^64 / phi spreads sequential ids, the common case for fleet data,
+ * evenly over the table instead of filling one contiguous run.
+ */
+std::size_t VehicleIndex::home(int id) const {
+    std::uint64_t h = static_cast<std::uint32_t>(id) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> 32) & mask;
+}
+
+void VehicleIndex::rehash(std::size_t capacity) {
+    std::vector<Entry> old;
+    old.swap(table);
+    table.assign(capacity, Entry{0, EMPTY});
+    mask = capacity - 1;
+    count = 0;
+    for (const Entry& e : old) {
+        if (e.slot != EMPTY) insert(e.id, e.slot);
+    }
+}
+
+/**
+ * @brief Grows the table so that `entries` ids fit without exceeding half occupancy.
+ *
+ * @param entries Number of ids the index should hold without rehashing.
+ */
+void VehicleIndex::reserve(std::size_t entries) {
+    std::size_t capacity = table.size();
+    while (capacity < entries * 2) capacity *= 2;
+    if (capacity != table.size()) rehash(capacity);
+}
+
+void VehicleIndex::clear() {
+    table.assign(MIN_CAPACITY, Entry{0, EMPTY});
+    mask = MIN_CAPACITY - 1;
+    count = 0;
+}
+
+/**
+ * @brief Looks up the slot of a vehicle.
+ *
+ * @param id Identifier of the vehicle.
+ * @return The slot stored for id, or NPOS if the id is not indexed.
+ */
+std::size_t VehicleIndex::find(int id) const {
+    for (std::size_t i = home(id);; i = (i + 1) & mask) {
+        const Entry& e = table[i];
+        if (e.slot == EMPTY) return NPOS;
+        if (e.id == id) return e.slot;
+    }
+}
+
+/**
+ * @brief Adds an id → slot mapping if the id is not already indexed.
+ *
+ * @param id Identifier of the vehicle.
+ * @param slot Fleet slot holding the vehicle.
+ * @return true if inserted, false if the id was already present (its slot is left unchanged).
+ *
+ * @throws std::length_error If slot does not fit the index's 32-bit slot field.
+ */
+bool VehicleIndex::insert(int id, std::size_t slot) {
+    if (slot >= EMPTY) {
+        throw std::length_error("VehicleIndex supports at most 2^32 - 1 slots");
+    }
+    if ((count + 1) * 2 > table.size()) rehash(table.size() * 2);
+
+    for (std::size_t i = home(id);; i = (i + 1) & mask) {
+        Entry& e = table[i];
+        if (e.slot == EMPTY) {
+            e = Entry{id, static_cast<std::uint32_t>(slot)};
+            ++count;
+            return true;
+        }
+        if (e.id == id) return false;
+    }
+}
+
+/**
+ * @brief Points an already indexed id at a new slot, or inserts it if absent.
+ *
+ * @param id Identifier of the vehicle.
+ * @param slot Fleet slot now holding the vehicle.
+ */
+void VehicleIndex::assign(int id, std::size_t slot) {
+    for (std::size_t i = home(id);; i = (i + 1) & mask) {
+        Entry& e = table[i];
+        if (e.slot == EMPTY) break;
+        if (e.id == id) {
+            e.slot = static_cast<std::uint32_t>(slot);
+            return;
+        }
+    }
+    insert(id, slot);
+}
+
+/**
+ * @brief Removes an id from the index.
+ *
+ * Entries following the removed one in its probe run are shifted back into the gap when their
+ * home position allows it, which keeps every remaining entry reachable without tombstones.
+ *
+ * @param id Identifier of the vehicle.
+ * @return true if the id was present and removed.
+ */
+bool VehicleIndex::erase(int id) {
+    std::size_t i = home(id);
+    for (;; i = (i + 1) & mask) {
+        if (table[i].slot == EMPTY) return false;
+        if (table[i].id == id) break;
+    }
+
+    std::size_t gap = i;
+    for (std::size_t j = (gap + 1) & mask; table[j].slot != EMPTY; j = (j + 1) & mask) {
+        // Move entry j into the gap unless its home lies cyclically in (gap, j].
+        std::size_t h = home(table[j].id);
+        bool reachable = gap <= j ? (gap < h && h <= j) : (gap < h || h <= j);
+        if (!reachable) {
+            table[gap] = table[j];
+            gap = j;
+        }
+    }
+    table[gap].slot = EMPTY;
+    --count;
+    return true;
+}
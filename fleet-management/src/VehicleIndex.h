@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash map from vehicle id to fleet slot. Linear probing over a
+// power-of-two table of 8-byte entries kept at most half full; erasure uses
+// backward shifting, so lookups never walk over tombstones.
+class VehicleIndex {
+public:
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+private:
+    struct Entry {
+        std::int32_t id;
+        std::uint32_t slot;
+    };
+    static constexpr std::uint32_t EMPTY = UINT32_MAX;
+
+    std::vector<Entry> table;
+    std::size_t mask{0};
+    std::size_t count{0};
+
+    std::size_t home(int id) const;
+    void rehash(std::size_t capacity);
+
+public:
+    VehicleIndex();
+
+    std::size_t size() const { return count; }
+    void reserve(std::size_t entries);
+    void clear();
+
+    std::size_t find(int id) const;
+    bool insert(int id, std::size_t slot);
+    void assign(int id, std::size_t slot);
+    bool erase(int id);
+};
@@ -0,0 +1,315 @@
+#include "../ConcurrentIngest.h"
+#include "../CsvLoader.h"
+#include "../FleetManager.h"
+#include "../ShardedFleetManager.h"
+#include "../SyntheticFleet.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Microbenchmark suite for CSV loading, construction, averages and alert evaluation.
+ *
+ * Usage: FleetBench [--max=N] [--csv-max=N] [--min-time=seconds] [--json=file]
+ *
+ * Runs every benchmark on synthetic fleets of 1e3, 1e4, ... vehicles up to --max (default 1e7;
+ * 1e8 needs about 3 GB of RAM). CSV loaders run up to --csv-max rows (default 1e6), the legacy
+ * stream loader at most 1e6 since it echoes every row. Each benchmark repeats until it has run
+ * for --min-time seconds (default 0.2) and reports the best and mean time per iteration as
+ * ns/vehicle, plus rows/s and MB/s for loaders. --json writes the same results as a JSON array
+ * for regression tracking. evaluateRules_N times the AlertRuleEngine fused pass with N rules;
+ * ingest_Np times ConcurrentIngest applying one reading per vehicle pushed by N producer threads,
+ * sharded_upsert_N the same readings applied by a ShardedFleetManager with N shards.
+ * analyses_pool runs averages, statistics, histograms and alert evaluation as concurrent jobs
+ * on a work-stealing TaskPool.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::size_t maxSize = 10000000;
+        std::size_t csvMaxSize = 1000000;
+        double minTime = 0.2;
+        std::string jsonFile;
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t size;
+        std::size_t iterations;
+        double bestSeconds;
+        double meanSeconds;
+        std::uint64_t bytes;
+    };
+
+    std::vector<Result> results;
+    Options options;
+
+    // Accepts and discards every character, so a stream writing to it still formats its output.
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    std::size_t parseSize(const char* text) {
+        return static_cast<std::size_t>(std::strtod(text, nullptr));
+    }
+
+    // Runs `body` until options.minTime has elapsed (at least once) and records the timings.
+    void measure(const std::string& name, std::size_t size, std::uint64_t bytes, const std::function<void()>& body) {
+        std::size_t iterations = 0;
+        double best = 1e300, total = 0;
+        do {
+            auto start = Clock::now();
+            body();
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            best = std::min(best, seconds);
+            total += seconds;
+            ++iterations;
+        } while (total < options.minTime);
+
+        Result r{name, size, iterations, best, total / iterations, bytes};
+        results.push_back(r);
+        std::printf("%-22s %11zu %7zu it  %10.2f ns/vehicle (best)  %10.2f (mean)", name.c_str(), size,
+                    iterations, best * 1e9 / size, r.meanSeconds * 1e9 / size);
+        if (bytes) {
+            std::printf("  %12.0f rows/s  %8.1f MB/s", size / best, bytes / best / (1024.0 * 1024.0));
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    void benchLoaders(std::size_t size) {
+        if (size > options.csvMaxSize) return;
+        std::string path = (std::filesystem::temp_directory_path() / "fleet_bench.csv").string();
+        std::uint64_t bytes = writeFleetCsv(generateSyntheticFleet(size), path);
+
+        measure("csv_mmap", size, bytes, [&] {
+            std::vector<Vehicle> vehicles;
+            loadVehicleDataMapped(path, vehicles);
+        });
+        measure("csv_parallel", size, bytes, [&] {
+            std::vector<Vehicle> vehicles;
+            loadVehicleDataParallel(path, vehicles);
+        });
+        measure("csv_columns", size, bytes, [&] { loadFleetColumns(path, 1); });
+        measure("csv_columns_mt", size, bytes, [&] { loadFleetColumns(path); });
+        if (size <= 1000000) {
+            // Discard the per-row echo so the loader pays for formatting but not terminal I/O. A null
+            // rdbuf would set badbit and skip the formatting too.
+            NullBuffer discard;
+            std::streambuf* saved = std::cout.rdbuf(&discard);
+            measure("csv_stream", size, bytes, [&] {
+                std::vector<Vehicle> vehicles;
+                loadVehicleData(path, vehicles);
+            });
+            std::cout.rdbuf(saved);
+        }
+        std::filesystem::remove(path);
+    }
+
+    // Building a FleetManager from a freshly loaded vector, by copy or by move, and vehicle by
+    // vehicle versus as one reserved batch. Each iteration includes producing the source vector.
+    // construct_move still transposes every row (a column store cannot adopt a vector of rows) and
+    // only frees the source early; construct_columns is the zero-copy path, adopting loaded columns.
+    void benchConstruction(std::size_t size) {
+        const FleetColumns columns = generateSyntheticFleet(size);
+        std::vector<Vehicle> source;
+        source.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) source.push_back(columns.vehicle(i));
+
+        measure("construct_copy", size, 0, [&] {
+            std::vector<Vehicle> loaded = source;
+            FleetManager fleet(loaded);
+        });
+        measure("construct_move", size, 0, [&] {
+            std::vector<Vehicle> loaded = source;
+            FleetManager fleet(std::move(loaded));
+        });
+        measure("construct_columns", size, 0, [&] {
+            FleetColumns loaded = columns;
+            FleetManager fleet(std::move(loaded));
+        });
+        measure("addVehicle_each", size, 0, [&] {
+            FleetManager fleet;
+            for (const Vehicle& vehicle : source) fleet.addVehicle(vehicle);
+        });
+        measure("addVehicles_range", size, 0, [&] {
+            FleetManager fleet;
+            fleet.addVehicles(source);
+        });
+        measure("emplaceVehicle", size, 0, [&] {
+            FleetManager fleet;
+            fleet.reserve(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                fleet.emplaceVehicle(columns.ids()[i], columns.speeds()[i], columns.temperatures()[i],
+                                     columns.fuels()[i]);
+            }
+        });
+    }
+
+    void benchFleet(std::size_t size, std::FILE* devNull) {
+        FleetManager fleet(generateSyntheticFleet(size));
+
+        fleet.setParallelism(1);
+        measure("computeAverages", size, 0, [&] { fleet.computeAverages(); });
+        fleet.setParallelism(0, 0);
+        measure("computeAverages_mt", size, 0, [&] { fleet.computeAverages(); });
+        measure("statistics", size, 0, [&] { fleet.statistics(); });
+        measure("histograms", size, 0, [&] { fleet.histograms(); });
+        measure("evaluateAlerts", size, 0, [&] { fleet.evaluateAlerts(); });
+
+        // The same scans as chunks on a work-stealing pool, singly and as four concurrent jobs.
+        TaskPool pool;
+        fleet.setTaskPool(&pool);
+        measure("computeAverages_pool", size, 0, [&] { fleet.computeAverages(); });
+        measure("analyses_pool", size, 0, [&] {
+            TaskGroup jobs;
+            pool.submit(jobs, [&] { fleet.computeAverages(); });
+            pool.submit(jobs, [&] { fleet.statistics(); });
+            pool.submit(jobs, [&] { fleet.histograms(); });
+            pool.submit(jobs, [&] { fleet.evaluateAlerts(); });
+            pool.wait(jobs);
+        });
+        fleet.setTaskPool(nullptr);
+
+        // Five configured rules, two of them deltas, in one fused pass.
+        AlertRuleEngine rules(defaultAlertRules());
+        std::vector<AlertRule> extra = defaultAlertRules();
+        extra.push_back({"overspeed", Metric::Speed, RuleKind::Above, 120.0, "Overspeed"});
+        extra.push_back({"temp_rise", Metric::Temperature, RuleKind::RiseAbove, 15.0, "Rapid Temperature Rise"});
+        extra.push_back({"fuel_drop", Metric::Fuel, RuleKind::DropAbove, 10.0, "Sudden Fuel Drop"});
+        AlertRuleEngine fiveRules(extra);
+        fiveRules.updateBaseline(fleet.fleetColumns());
+        measure("evaluateRules_2", size, 0, [&] { rules.evaluate(fleet.fleetColumns()); });
+        measure("evaluateRules_5", size, 0, [&] { fiveRules.evaluate(fleet.fleetColumns()); });
+
+        // checkAlerts writes to stdout; time the same evaluate + format + write against /dev/null.
+        AlertReporter reporter;
+        int fd = fileno(devNull);
+        measure("checkAlerts", size, 0, [&] {
+            reporter.format(fleet.evaluateAlerts(), fleet.fleetColumns().ids());
+            reporter.write(fd);
+        });
+        // Steady state: the readings do not change, so only the state pass remains.
+        fleet.alertChanges();
+        measure("checkAlertChanges", size, 0, [&] {
+            reporter.format(fleet.alertChanges(), fleet.fleetColumns().ids());
+            reporter.write(fd);
+        });
+    }
+
+    // Concurrent ingestion of `size` readings for existing vehicles, split evenly across 1 to 32
+    // producer threads that each own a slice of the ids, all drained by the single applier.
+    void benchIngest(std::size_t size) {
+        FleetManager fleet(generateSyntheticFleet(size));
+        for (std::size_t producers = 1; producers <= 32; producers *= 2) {
+            measure("ingest_" + std::to_string(producers) + "p", size, 0, [&] {
+                ConcurrentIngest ingest(fleet, producers);
+                ingest.start();
+                std::vector<std::thread> threads;
+                for (std::size_t p = 0; p < producers; ++p) {
+                    threads.emplace_back([&ingest, p, producers, size] {
+                        ConcurrentIngest::Producer producer = ingest.producer(p);
+                        for (std::size_t i = p; i < size; i += producers) {
+                            producer.push({static_cast<int>(i + 1), 50.0, 90.0, 50.0});
+                        }
+                    });
+                }
+                for (std::thread& thread : threads) thread.join();
+                ingest.stop();
+            });
+        }
+
+        // The same readings submitted in batches to a sharded fleet, one worker per shard.
+        const FleetColumns& columns = fleet.fleetColumns();
+        std::vector<TelemetryReading> readings(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            readings[i] = {columns.ids()[i], columns.speeds()[i], columns.temperatures()[i], columns.fuels()[i]};
+        }
+        for (std::size_t shards = 1; shards <= 8; shards *= 2) {
+            ShardedFleetManager sharded(columns, shards);
+            measure("sharded_upsert_" + std::to_string(shards), size, 0, [&] {
+                for (std::size_t i = 0; i < size; i += 1024) {
+                    sharded.upsertReadings(readings.data() + i, std::min<std::size_t>(1024, size - i));
+                }
+                sharded.flush();
+            });
+        }
+    }
+
+    void writeJson(const std::string& filename) {
+        std::ofstream out(filename);
+        out.precision(10);
+        out << "[\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "  {\"name\": \"" << r.name << "\", \"size\": " << r.size
+                << ", \"iterations\": " << r.iterations
+                << ", \"best_seconds\": " << r.bestSeconds
+                << ", \"mean_seconds\": " << r.meanSeconds
+                << ", \"ns_per_vehicle\": " << r.bestSeconds * 1e9 / r.size;
+            if (r.bytes) {
+                out << ", \"bytes\": " << r.bytes
+                    << ", \"rows_per_second\": " << r.size / r.bestSeconds
+                    << ", \"mb_per_second\": " << r.bytes / r.bestSeconds / (1024.0 * 1024.0);
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--max=", 6) == 0) {
+            options.maxSize = parseSize(argv[i] + 6);
+        } else if (std::strncmp(argv[i], "--csv-max=", 10) == 0) {
+            options.csvMaxSize = parseSize(argv[i] + 10);
+        } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            options.minTime = std::strtod(argv[i] + 11, nullptr);
+        } else if (std::strncmp(argv[i], "--json=", 7) == 0) {
+            options.jsonFile = argv[i] + 7;
+        } else {
+            std::cerr << "Usage: FleetBench [--max=N] [--csv-max=N] [--min-time=seconds] [--json=file]\n";
+            return 1;
+        }
+    }
+
+#ifdef _WIN32
+    std::FILE* devNull = std::fopen("NUL", "wb");
+#else
+    std::FILE* devNull = std::fopen("/dev/null", "wb");
+#endif
+    if (devNull == nullptr) {
+        std::cerr << "Unable to open null device\n";
+        return 1;
+    }
+
+    try {
+        for (std::size_t size = 1000; size <= options.maxSize; size *= 10) {
+            benchLoaders(size);
+            benchConstruction(size);
+            benchFleet(size, devNull);
+            benchIngest(size);
+        }
+        if (!options.jsonFile.empty()) writeJson(options.jsonFile);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::fclose(devNull);
+        return 1;
+    }
+    std::fclose(devNull);
+    return 0;
+}
@@ -1,88 +1,250 @@
-#include <iostream>
+#include <chrono>
 #include <fstream>
-#include <sstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <cstring>
+#include <string>
+#include <utility>
 #include <vector>
 #include "Vehicle.h"
 #include "FleetManager.h"
+#include "CsvLoader.h"
+#include "TelemetryStream.h"
+#include "BinarySnapshot.h"
+#include "Instrumentation.h"
+#include "TaskPool.h"
 
-/**
- * @brief Loads vehicle data from a CSV file into a vector of Vehicle objects.
- *
- * This function reads vehicle information from the specified CSV file, parses each line,
- * and constructs Vehicle objects which are appended to the provided vector. The CSV file
- * is expected to have the following columns: ID, Speed, Temperature, Fuel. The first line
- * (header) is skipped. If a line cannot be parsed, an error message is printed and the line is skipped.
- *
- * @param filename The path to the CSV file containing vehicle data.
- * @param vehicles Reference to a vector where the loaded Vehicle objects will be stored.
- *
- * @throws std::runtime_error If the file cannot be opened.
- */
-void loadVehicleData(const std::string& filename, std::vector<Vehicle>& vehicles) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Unable to open file: " + filename);
+namespace {
+    struct Options {
+        // Use the correct path relative to where the executable is run
+        std::string dataFile = "fleet-management/data/vehicles.csv";
+        bool dataFileGiven = false;
+        bool useMappedLoader = false;
+        bool useParallelLoader = false;
+        unsigned loaderThreads = 0;
+        std::string snapshotIn;
+        std::string snapshotOut;
+        bool streamMode = false;
+        std::string streamSource = "-";
+        std::string rulesFile;
+        bool profile = false;
+        std::string profileFile;
+    };
+
+    Options parseOptions(int argc, char* argv[]) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--mmap") == 0) {
+                options.useMappedLoader = true;
+            } else if (std::strncmp(argv[i], "--parallel", 10) == 0) {
+                options.useParallelLoader = true;
+                if (argv[i][10] == '=') options.loaderThreads = static_cast<unsigned>(std::stoul(argv[i] + 11));
+            } else if (std::strncmp(argv[i], "--stream", 8) == 0) {
+                options.streamMode = true;
+                if (argv[i][8] == '=') options.streamSource = argv[i] + 9;
+            } else if (std::strncmp(argv[i], "--snapshot=", 11) == 0) {
+                options.snapshotIn = argv[i] + 11;
+            } else if (std::strncmp(argv[i], "--rules=", 8) == 0) {
+                options.rulesFile = argv[i] + 8;
+            } else if (std::strncmp(argv[i], "--profile", 9) == 0) {
+                options.profile = true;
+                if (argv[i][9] == '=') options.profileFile = argv[i] + 10;
+            } else if (std::strncmp(argv[i], "--write-snapshot=", 17) == 0) {
+                options.snapshotOut = argv[i] + 17;
+            } else {
+                options.dataFile = argv[i];
+                options.dataFileGiven = true;
+            }
+        }
+        return options;
     }
-    
-    std::string line;
-    // Skip header line if exists
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        std::string idStr, speedStr, tempStr, fuelStr;
-
-        std::getline(ss, idStr, ',');
-        std::getline(ss, speedStr, ',');
-        std::getline(ss, tempStr, ',');
-        std::getline(ss, fuelStr);
-
-        try {
-            int id = std::stoi(idStr);
-            double speed = std::stod(speedStr);
-            double temperature = std::stod(tempStr);
-            double fuel = std::stod(fuelStr);
-
-            vehicles.emplace_back(id, speed, temperature, fuel);
-            std::cout << "Loaded vehicle ID: " << id << std::endl;
+
+    // Loads the fleet from the binary snapshot if one was given, otherwise from the CSV file.
+    FleetColumns loadFleet(const Options& options) {
+        instrumentation::ScopedTimer timer(instrumentation::Stage::Load);
+        if (!options.snapshotIn.empty()) {
+            return SnapshotView(options.snapshotIn).toColumns();
         }
-        catch (const std::exception& e) {
-            std::cerr << "Error parsing line: " << line << std::endl;
-            continue;
+
+        // The mapped loaders parse straight into the columns, which are then moved, never copied.
+        if (options.useParallelLoader) {
+            return loadFleetColumns(options.dataFile, options.loaderThreads);
+        }
+        // Stream mode also seeds through them: there stdout carries the alerts, and the stream
+        // loader would echo every seed row onto it.
+        if (options.useMappedLoader || options.streamMode) {
+            return loadFleetColumns(options.dataFile, 1);
         }
-    }
-}
 
-int main() {
-    try {
         std::vector<Vehicle> vehicles;
-        // Use the correct path relative to where the executable is run
-        loadVehicleData("fleet-management/data/vehicles.csv", vehicles);
+        loadVehicleData(options.dataFile, vehicles);
+        return FleetColumns(vehicles);
+    }
+
+    void printAverages(const FleetManager& fleetManager) {
+        std::cout << "Average Speed: " << fleetManager.averageSpeed() << " km/h\n";
+        std::cout << "Average Temperature: " << fleetManager.averageTemperature() << " °C\n";
+        std::cout << "Average Fuel: " << fleetManager.averageFuel() << "%\n\n";
+    }
+
+    // Fleet-wide averages of the readings streamed in over the last minute, five minutes and hour.
+    void printWindows(const SlidingFleetStats& windows) {
+        using namespace std::chrono;
+        const SlidingFleetStats::Duration now = SlidingFleetStats::now();
+        const std::pair<const char*, SlidingFleetStats::Duration> spans[] = {
+            {"1 min", minutes(1)}, {"5 min", minutes(5)}, {"1 h", hours(1)}};
+        for (const auto& span : spans) {
+            FleetStats stats = windows.query(now, span.second);
+            std::cout << "Last " << span.first << ": " << stats.count() << " readings";
+            if (stats.count()) {
+                std::cout << ", speed " << stats.speed.mean << " km/h, temperature " << stats.temperature.mean
+                          << " °C, fuel " << stats.fuel.mean << "%";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    int run(const Options& options) {
+        if (options.streamMode) {
+            bool seeded = options.dataFileGiven || !options.snapshotIn.empty();
+            FleetManager fleetManager(seeded ? loadFleet(options) : FleetColumns());
+            SlidingFleetStats windows;
+            TelemetryStream stream(fleetManager);
+            stream.trackWindows(windows);
+            std::unique_ptr<AlertRuleEngine> rules;
+            if (!options.rulesFile.empty()) {
+                rules = std::make_unique<AlertRuleEngine>(loadAlertRules(options.rulesFile));
+                stream.useRules(*rules);
+            }
+            stream.run(options.streamSource);
+
+            std::cout << "\n--- Stream Summary ---\n\n";
+            std::cout << "Records Applied: " << stream.records() << "\n";
+            std::cout << "Vehicles Tracked: " << fleetManager.size() << "\n";
+            printAverages(fleetManager);
+            printWindows(windows);
+            return 0;
+        }
 
-        if (vehicles.empty()) {
+        FleetColumns fleet = loadFleet(options);
+        if (fleet.empty()) {
             std::cerr << "No vehicles loaded from file" << std::endl;
             return 1;
         }
 
+        if (!options.snapshotOut.empty()) {
+            writeBinarySnapshot(fleet, options.snapshotOut);
+            std::cout << "Wrote " << fleet.size() << " vehicles to " << options.snapshotOut << "\n";
+            return 0;
+        }
+
         std::cout << "\n--- Fleet Management System ---\n\n";
 
-        // Create FleetManager with loaded vehicles
-        FleetManager fleetManager(vehicles);
-        
-        // Compute and display averages
-        fleetManager.computeAverages();
-        std::cout << "Average Speed: " << fleetManager.averageSpeed() << " km/h\n";
-        std::cout << "Average Temperature: " << fleetManager.averageTemperature() << " °C\n";
-        std::cout << "Average Fuel: " << fleetManager.averageFuel() << "%\n\n";
-        
-        // Display alerts
+        // Create FleetManager with loaded vehicles. Fleets large enough for parallel scans run them
+        // as chunks on a work-stealing pool; smaller ones are scanned on this thread, without
+        // starting any workers.
+        FleetManager fleetManager(std::move(fleet));
+        std::optional<TaskPool> pool;
+        if (fleetManager.size() >= FleetManager::DEFAULT_PARALLEL_THRESHOLD) {
+            pool.emplace();
+            fleetManager.setTaskPool(&*pool);
+        }
+        std::unique_ptr<AlertRuleEngine> rules;
+        if (!options.rulesFile.empty()) {
+            rules = std::make_unique<AlertRuleEngine>(loadAlertRules(options.rulesFile));
+        }
+
+        const int* ids = fleetManager.fleetColumns().ids();
+        AlertReporter alerts;
+        auto evaluateAlerts = [&] {
+            if (rules) {
+                alerts.format(fleetManager.evaluateAlerts(*rules), rules->rules(), ids);
+            } else {
+                alerts.format(fleetManager.evaluateAlerts(), ids);
+            }
+        };
+        if (pool) {
+            // The analyses run as concurrent jobs over the same columns, idle workers stealing
+            // chunks from whichever job has work left; their results are printed in order afterwards.
+            TaskGroup analyses;
+            pool->submit(analyses, [&] { fleetManager.computeAverages(); });
+            pool->submit(analyses, evaluateAlerts);
+            pool->wait(analyses);
+        } else {
+            fleetManager.computeAverages();
+            evaluateAlerts();
+        }
+
+        // Display averages and alerts
+        printAverages(fleetManager);
         std::cout << "--- Alerts ---\n";
-        fleetManager.checkAlerts();
+        alerts.write();
 
         return 0;
     }
+
+    // Dumps the instrumentation totals as JSON to the --profile file, or as a summary on stderr.
+    void reportProfile(const Options& options) {
+        if (!options.profile) return;
+        std::cout.flush();
+        if (options.profileFile.empty()) {
+            instrumentation::writeSummary(std::cerr);
+            return;
+        }
+        std::ofstream out(options.profileFile);
+        if (!out.is_open()) {
+            throw std::runtime_error("Unable to create file: " + options.profileFile);
+        }
+        instrumentation::writeJson(out);
+    }
+}
+
+/**
+ * @brief Entry point for the Fleet Management application.
+ *
+ * Usage: FleetManagement [--mmap | --parallel[=N] | --snapshot=file] [--write-snapshot=file]
+ *                        [--rules=file] [--stream[=source]] [--profile[=file]] [csv-file]
+ *
+ * Loads the fleet from csv-file (default: fleet-management/data/vehicles.csv, relative to the
+ * repository root), prints fleet averages and then any alerts. With --mmap the file is loaded
+ * through the memory-mapped zero-copy parser instead of the line-by-line stream parser; with
+ * --parallel the mapped file is parsed in chunks on N worker threads (default: all cores). Both
+ * parse directly into the fleet columns (loadFleetColumns), which are moved into the FleetManager.
+ * With --snapshot the fleet is loaded from a binary columnar snapshot instead of any CSV file.
+ *
+ * With --rules the alerts are checked against the rules in file (see parseAlertRules) instead of
+ * the built-in overheating and low fuel thresholds. A single check has no earlier readings to
+ * compare with, so rise/drop rules only fire in --stream mode, where each reading is checked against
+ * the rules and compared with the same vehicle's previous reading.
+ *
+ * With --write-snapshot the loaded fleet is saved as a binary snapshot and the program exits,
+ * which converts a CSV file into the snapshot format.
+ *
+ * With --stream the program instead runs as a pipeline stage: it reads `id,speed,temperature,fuel`
+ * records from source (a file or FIFO; default "-" for stdin) until end of stream, applies each one
+ * to the fleet and writes alerts as they are raised or cleared. The fleet starts empty unless a csv-file or
+ * snapshot is given explicitly, in which case that is loaded first. Averages are printed at end
+ * of stream, followed by the rolling averages of the readings received in the last minute, five
+ * minutes and hour.
+ *
+ * With --profile the time spent in each pipeline stage and the rows parsed, parse failures, alerts
+ * emitted and bytes read are printed to stderr on exit, or written as JSON with --profile=file.
+ *
+ * @return int Returns 0 on success, or 1 if no vehicles could be loaded or a fatal error occurs.
+ */
+int main(int argc, char* argv[]) {
+    try {
+        Options options = parseOptions(argc, argv);
+        instrumentation::enable(options.profile);
+        int status = run(options);
+        reportProfile(options);
+        return status;
+    }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
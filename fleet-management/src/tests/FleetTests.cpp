@@ -2,8 +2,49 @@
 #include "catch.hpp"
 #include "../Vehicle.h"
 #include "../FleetManager.h"
+#include "../CsvLoader.h"
+#include "../SimdKernels.h"
+#include "../ParallelReduce.h"
+#include "../VehicleIndex.h"
+#include "../TelemetryStream.h"
+#include "../BinarySnapshot.h"
+#include "../SyntheticFleet.h"
+#include "../Instrumentation.h"
+#include "../TelemetryHistory.h"
+#include "../SlidingFleetStats.h"
+#include "../MetricHistogram.h"
+#include "../ConcurrentIngest.h"
+#include "../SpscQueue.h"
+#include "../ShardedFleetManager.h"
+#include "../FleetReadView.h"
+#include "../TaskPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+namespace {
+    // Writes `contents` to a fresh file in the temp directory and removes it on scope exit.
+    struct TempCsv {
+        std::string path;
+        explicit TempCsv(const std::string& contents, const char* name = "fleet_tests.csv")
+            : path((std::filesystem::temp_directory_path() / name).string()) {
+            std::ofstream out(path, std::ios::binary);
+            out << contents;
+        }
+        ~TempCsv() { std::remove(path.c_str()); }
+    };
+}
+
 // Existing test cases...
 
 // Additional 20 edge/bottleneck test cases
@@ -236,4 +277,1187 @@ TEST_CASE("FleetManager Zero and Nonzero Mix", "[edge]") {
         REQUIRE(fm.averageTemperature() == 50);
         REQUIRE(fm.averageFuel() == 50);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("CSV Record Parsing", "[loader]") {
+    VehicleRecord r{};
+    SECTION("Plain row") {
+        const std::string row = "7,60.5,90,50.25";
+        REQUIRE(parseVehicleRecord(row.data(), row.data() + row.size(), r));
+        REQUIRE(r.id == 7);
+        REQUIRE(r.speed == 60.5);
+        REQUIRE(r.temperature == 90);
+        REQUIRE(r.fuel == 50.25);
+    }
+    SECTION("Whitespace and CRLF") {
+        const std::string row = " 7 , -60.5,+90,50\r";
+        REQUIRE(parseVehicleRecord(row.data(), row.data() + row.size(), r));
+        REQUIRE(r.speed == -60.5);
+        REQUIRE(r.temperature == 90);
+    }
+    SECTION("Malformed rows") {
+        for (std::string row : {"", "1,2,3", "1,2,3,4,5", "x,2,3,4", "1,2,3,4abc"})
+            REQUIRE_FALSE(parseVehicleRecord(row.data(), row.data() + row.size(), r));
+    }
+}
+
+TEST_CASE("Mapped Loader Matches Stream Loader", "[loader]") {
+    TempCsv csv("id,speed,temperature,fuel\n1,60,90,50\n2,70,115,20\nbad,row\n\n3,50.5,100,10\r\n4,80,130,30");
+    std::vector<Vehicle> streamed, mapped;
+    loadVehicleData(csv.path, streamed);
+    loadVehicleDataMapped(csv.path, mapped);
+
+    REQUIRE(mapped.size() == 4);
+    REQUIRE(mapped.size() == streamed.size());
+    for (std::size_t i = 0; i < mapped.size(); ++i) {
+        REQUIRE(mapped[i].getId() == streamed[i].getId());
+        REQUIRE(mapped[i].getSpeed() == streamed[i].getSpeed());
+        REQUIRE(mapped[i].getTemperature() == streamed[i].getTemperature());
+        REQUIRE(mapped[i].getFuel() == streamed[i].getFuel());
+    }
+}
+
+TEST_CASE("Mapped Loader Edge Cases", "[loader]") {
+    SECTION("Empty file") {
+        TempCsv csv("");
+        std::vector<Vehicle> vehicles;
+        REQUIRE_NOTHROW(loadVehicleDataMapped(csv.path, vehicles));
+        REQUIRE(vehicles.empty());
+    }
+    SECTION("Missing file") {
+        std::vector<Vehicle> vehicles;
+        REQUIRE_THROWS_AS(loadVehicleDataMapped("does/not/exist.csv", vehicles), std::runtime_error);
+    }
+}
+
+TEST_CASE("Parallel Loader Preserves Row Order", "[loader]") {
+    SECTION("Multi-chunk file") {
+        std::string contents = "id,speed,temperature,fuel\n";
+        for (int i = 0; i < 200000; ++i) {
+            contents += std::to_string(i) + "," + std::to_string(i % 140) + ".5,"
+                      + std::to_string(60 + i % 70) + "," + std::to_string(i % 100) + "\n";
+            if (i % 50000 == 7) contents += "garbage\n";
+        }
+        TempCsv csv(contents);
+
+        std::vector<Vehicle> mapped, parallel;
+        loadVehicleDataMapped(csv.path, mapped);
+        loadVehicleDataParallel(csv.path, parallel, 4);
+
+        REQUIRE(parallel.size() == 200000);
+        REQUIRE(parallel.size() == mapped.size());
+        for (std::size_t i = 0; i < parallel.size(); ++i) {
+            REQUIRE(parallel[i].getId() == static_cast<int>(i));
+            REQUIRE(parallel[i].getFuel() == mapped[i].getFuel());
+        }
+
+        // Garbage lines leave gaps in the pre-sized slices that must be closed up in order.
+        for (unsigned threads : {1u, 4u}) {
+            FleetColumns columns = loadFleetColumns(csv.path, threads);
+            REQUIRE(columns.size() == 200000);
+            for (std::size_t i = 0; i < columns.size(); ++i) {
+                REQUIRE(columns.ids()[i] == static_cast<int>(i));
+                REQUIRE(columns.speeds()[i] == mapped[i].getSpeed());
+                REQUIRE(columns.fuels()[i] == mapped[i].getFuel());
+            }
+        }
+    }
+    SECTION("Small file parsed inline") {
+        TempCsv csv("id,speed,temperature,fuel\n1,60,90,50\n2,70,115,20");
+        std::vector<Vehicle> vehicles;
+        loadVehicleDataParallel(csv.path, vehicles, 8);
+        REQUIRE(vehicles.size() == 2);
+        REQUIRE(vehicles[1].getTemperature() == 115);
+
+        FleetColumns columns = loadFleetColumns(csv.path, 8);
+        REQUIRE(columns.size() == 2);
+        REQUIRE(columns.temperatures()[1] == 115);
+        REQUIRE(loadFleetColumns(TempCsv("", "fleet_empty.csv").path).empty());
+    }
+}
+
+TEST_CASE("FleetColumns Layout", "[columns]") {
+    std::vector<Vehicle> vehicles;
+    vehicles.emplace_back(1, 60, 90, 50);
+    vehicles.emplace_back(2, 70, 115, 20);
+    FleetColumns columns(vehicles);
+
+    REQUIRE(columns.size() == 2);
+    REQUIRE(columns.ids()[1] == 2);
+    REQUIRE(columns.speeds()[0] == 60);
+    REQUIRE(columns.temperatures()[1] == 115);
+    REQUIRE(columns.fuels()[0] == 50);
+
+    FleetColumns adopted({7, 8}, {1, 2}, {3, 4}, {5, 6});
+    REQUIRE(adopted.size() == 2);
+    REQUIRE(adopted.fuels()[1] == 6);
+    REQUIRE_THROWS_AS(FleetColumns({1}, {1, 2}, {1}, {1}), std::invalid_argument);
+
+    columns.append(3, 50, 100, 10);
+    Vehicle v = columns.vehicle(2);
+    REQUIRE(v.getId() == 3);
+    REQUIRE(v.getTemperature() == 100);
+
+    FleetManager fm(vehicles);
+    REQUIRE(fm.fleetColumns().size() == 2);
+}
+
+TEST_CASE("FleetStats Single Pass", "[stats]") {
+    std::vector<Vehicle> vehicles;
+    vehicles.emplace_back(1, 60, 90, 50);
+    vehicles.emplace_back(2, 70, 115, 20);
+    vehicles.emplace_back(3, 50, 100, 10);
+    vehicles.emplace_back(4, 80, 130, 30);
+    FleetManager fm(vehicles);
+    FleetStats stats = fm.statistics();
+
+    REQUIRE(stats.count() == 4);
+    REQUIRE(stats.speed.mean == Approx(65));
+    REQUIRE(stats.speed.sum() == Approx(260));
+    REQUIRE(stats.speed.min == 50);
+    REQUIRE(stats.speed.max == 80);
+    REQUIRE(stats.speed.variance() == Approx(125));
+    REQUIRE(stats.temperature.max == 130);
+    REQUIRE(stats.fuel.min == 10);
+    REQUIRE(stats.fuel.variance() == Approx(218.75));
+
+    SECTION("Merging partial ranges matches the full pass") {
+        FleetStats merged = computeFleetStats(fm.fleetColumns(), 0, 1);
+        merged.merge(computeFleetStats(fm.fleetColumns(), 1, 4));
+        REQUIRE(merged.count() == 4);
+        REQUIRE(merged.temperature.mean == Approx(stats.temperature.mean));
+        REQUIRE(merged.temperature.variance() == Approx(stats.temperature.variance()));
+        REQUIRE(merged.fuel.min == stats.fuel.min);
+    }
+    SECTION("Welford add matches the batch kernel") {
+        MetricStats incremental;
+        for (double v : {60.0, 70.0, 50.0, 80.0}) incremental.add(v);
+        REQUIRE(incremental.mean == Approx(stats.speed.mean));
+        REQUIRE(incremental.variance() == Approx(stats.speed.variance()));
+    }
+    SECTION("Empty fleet") {
+        FleetManager empty(std::vector<Vehicle>{});
+        REQUIRE(empty.statistics().count() == 0);
+        REQUIRE(empty.statistics().speed.variance() == 0);
+    }
+}
+
+TEST_CASE("SIMD Kernels Match Scalar Loops", "[simd]") {
+    // 131 values: two full mask words plus a partial one, and a tail for every vector width.
+    std::vector<double> values;
+    for (int i = 0; i < 131; ++i) values.push_back((i * 37) % 200 - 50.5);
+    values[5] = 110.0; // exactly at the threshold: neither greater nor less
+
+    double expectedSum = 0;
+    for (double v : values) expectedSum += v;
+
+    // Every instruction set the CPU supports, not only the one the dispatcher picks.
+    const std::vector<simd::KernelSet>& kernels = simd::supportedKernels();
+    REQUIRE(std::string(kernels.front().isa) == simd::activeIsa());
+    REQUIRE(std::string(kernels.back().isa) == "scalar");
+    for (const simd::KernelSet& k : kernels) {
+        INFO("isa " << k.isa);
+        for (std::size_t count : {std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(64), values.size()}) {
+            double expected = 0;
+            for (std::size_t i = 0; i < count; ++i) expected += values[i];
+            REQUIRE(k.sum(values.data(), count) == Approx(expected));
+        }
+
+        std::vector<std::uint64_t> greater(simd::maskWords(values.size()), ~0ull);
+        std::vector<std::uint64_t> less(simd::maskWords(values.size()), ~0ull);
+        k.maskGreater(values.data(), values.size(), 110.0, greater.data());
+        k.maskLess(values.data(), values.size(), 110.0, less.data());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            INFO("slot " << i);
+            REQUIRE(((greater[i / 64] >> (i % 64)) & 1) == (values[i] > 110.0 ? 1u : 0u));
+            REQUIRE(((less[i / 64] >> (i % 64)) & 1) == (values[i] < 110.0 ? 1u : 0u));
+        }
+        REQUIRE((greater.back() >> (values.size() % 64)) == 0);
+        REQUIRE((less.back() >> (values.size() % 64)) == 0);
+    }
+
+    REQUIRE(simd::sum(values.data(), values.size()) == Approx(expectedSum));
+    REQUIRE(simd::sum(values.data(), 0) == 0);
+    REQUIRE(simd::lowestBit(0x80ull) == 7);
+}
+
+TEST_CASE("Alert Engine Masks And Report", "[alerts]") {
+    std::vector<Vehicle> vehicles;
+    vehicles.emplace_back(1, 60, 120, 10); // both alerts
+    vehicles.emplace_back(2, 60, 90, 50);  // no alert
+    vehicles.emplace_back(3, 60, 120, 50); // temp alert
+    vehicles.emplace_back(-4, 60, 110, 10); // fuel alert; 110 is not above the limit
+    FleetManager fm(vehicles);
+
+    AlertMasks masks = fm.evaluateAlerts();
+    REQUIRE(masks.size == 4);
+    REQUIRE(masks.overheatingCount() == 2);
+    REQUIRE(masks.lowFuelCount() == 2);
+    REQUIRE(masks.isOverheating(0));
+    REQUIRE_FALSE(masks.isOverheating(3));
+    REQUIRE(masks.hasLowFuel(3));
+
+    AlertReporter reporter;
+    REQUIRE(reporter.format(masks, fm.fleetColumns().ids()) ==
+            "Vehicle ID 1: Critical Overheating\n"
+            "Vehicle ID 1: Low Fuel Warning\n"
+            "Vehicle ID 3: Critical Overheating\n"
+            "Vehicle ID -4: Low Fuel Warning\n");
+
+    SECTION("No alerts formats nothing") {
+        FleetManager quiet(std::vector<Vehicle>{Vehicle(1, 60, 90, 50)});
+        REQUIRE(reporter.format(quiet.evaluateAlerts(), quiet.fleetColumns().ids()).empty());
+    }
+}
+
+TEST_CASE("FleetManager Parallel Reduction", "[performance]") {
+    std::vector<Vehicle> vehicles;
+    for (int i = 0; i < 100000; ++i)
+        vehicles.emplace_back(i, i % 140, 60 + i % 70, 0.1 * (i % 1000));
+    FleetManager serial(vehicles);
+    serial.setParallelism(1);
+    serial.computeAverages();
+
+    for (unsigned threads : {2u, 3u, 8u}) {
+        FleetManager parallel(vehicles);
+        parallel.setParallelism(threads, 1000);
+        parallel.computeAverages();
+        REQUIRE(parallel.averageSpeed() == Approx(serial.averageSpeed()));
+        REQUIRE(parallel.averageTemperature() == Approx(serial.averageTemperature()));
+        REQUIRE(parallel.averageFuel() == Approx(serial.averageFuel()).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("Stable Sum Accuracy", "[precision]") {
+    // 1e6 copies of 0.1: naive left-to-right summation drifts in the 1e-6 range.
+    std::vector<double> values(1000000, 0.1);
+    REQUIRE(stableSum(values.data(), values.size()) == Approx(100000.0).epsilon(1e-14));
+    REQUIRE(stableSum(values.data(), 0) == 0);
+}
+
+TEST_CASE("FleetManager Running Statistics", "[running]") {
+    std::vector<Vehicle> vehicles;
+    vehicles.emplace_back(1, 60, 90, 50);
+    vehicles.emplace_back(2, 70, 115, 20);
+    FleetManager fm(vehicles);
+
+    SECTION("Averages are current without computeAverages") {
+        REQUIRE(fm.averageSpeed() == Approx(65));
+        REQUIRE(fm.averageTemperature() == Approx(102.5));
+    }
+    SECTION("Add, update and remove keep mean and variance exact") {
+        fm.addVehicle(Vehicle(3, 50, 100, 10));
+        REQUIRE(fm.size() == 3);
+        REQUIRE(fm.averageSpeed() == Approx(60));
+        REQUIRE(fm.runningMoments().speed.variance() == Approx(200.0 / 3));
+
+        REQUIRE(fm.updateReading(2, 80, 130, 30));
+        REQUIRE(fm.averageTemperature() == Approx(320.0 / 3));
+        REQUIRE(fm.runningMoments().fuel.variance() == Approx(fm.statistics().fuel.variance()));
+
+        REQUIRE(fm.removeVehicle(1));
+        REQUIRE(fm.size() == 2);
+        REQUIRE(fm.averageSpeed() == Approx(65));
+        REQUIRE(fm.runningMoments().speed.variance() == Approx(fm.statistics().speed.variance()));
+
+        REQUIRE_FALSE(fm.removeVehicle(1));
+        REQUIRE_FALSE(fm.updateReading(99, 0, 0, 0));
+    }
+    SECTION("Removing every vehicle resets the averages") {
+        REQUIRE(fm.removeVehicle(1));
+        REQUIRE(fm.removeVehicle(2));
+        REQUIRE(fm.averageSpeed() == 0);
+        REQUIRE(fm.runningMoments().fuel.variance() == 0);
+        fm.addVehicle(Vehicle(5, 40, 80, 60));
+        REQUIRE(fm.averageFuel() == 60);
+    }
+}
+
+TEST_CASE("FleetManager Duplicate Vehicle Ids", "[edge]") {
+    SECTION("Adding a known id replaces its readings") {
+        FleetManager fm;
+        fm.addVehicle(Vehicle(1, 60, 90, 50));
+        fm.addVehicle(Vehicle(1, 70, 95, 40));
+        fm.emplaceVehicle(2, 80, 100, 30);
+        REQUIRE(fm.size() == 2);
+        REQUIRE(fm.fleetColumns().speeds()[0] == 70);
+        REQUIRE(fm.averageSpeed() == Approx(75));
+
+        REQUIRE(fm.removeVehicle(1));
+        REQUIRE(fm.size() == 1);
+        REQUIRE_FALSE(fm.contains(1));
+        REQUIRE(fm.fleetColumns().ids()[0] == 2);
+        REQUIRE(fm.averageSpeed() == Approx(80));
+        fm.upsertReading(1, 50, 90, 50);
+        REQUIRE(fm.size() == 2);
+    }
+    SECTION("Repeated ids in the initial fleet keep the last reading in the first slot") {
+        std::ostringstream errors;
+        std::streambuf* saved = std::cerr.rdbuf(errors.rdbuf());
+        FleetManager fm(std::vector<Vehicle>{Vehicle(1, 60, 90, 50), Vehicle(2, 80, 100, 30),
+                                             Vehicle(1, 70, 95, 40), Vehicle(3, 40, 80, 20)});
+        std::cerr.rdbuf(saved);
+        REQUIRE(errors.str() == "Duplicate vehicle ID 1: row replaces the vehicle's earlier readings\n");
+        REQUIRE(fm.size() == 3);
+        REQUIRE(fm.fleetColumns().ids()[0] == 1);
+        REQUIRE(fm.fleetColumns().speeds()[0] == 70);
+        REQUIRE(fm.fleetColumns().ids()[2] == 3);
+        REQUIRE(fm.slotOf(3) == 2);
+        REQUIRE(fm.averageSpeed() == Approx(190.0 / 3));
+
+        REQUIRE(fm.removeVehicle(1));
+        REQUIRE_FALSE(fm.contains(1));
+        REQUIRE(fm.size() == 2);
+        REQUIRE(fm.statistics().speed.sum() == Approx(120));
+    }
+}
+
+TEST_CASE("Vehicle Reading Update", "[edge]") {
+    Vehicle v(4, 60, 90, 50);
+    v.updateReading(70, 120, 10);
+    REQUIRE(v.getId() == 4);
+    REQUIRE(v.getSpeed() == 70);
+    REQUIRE(v.getTemperature() == 120);
+    REQUIRE(v.getFuel() == 10);
+}
+
+TEST_CASE("VehicleIndex Open Addressing", "[index]") {
+    VehicleIndex index;
+    for (int id = -500; id < 500; ++id)
+        REQUIRE(index.insert(id * 7, static_cast<std::size_t>(id + 500)));
+    REQUIRE(index.size() == 1000);
+    REQUIRE_FALSE(index.insert(0, 1));
+    REQUIRE(index.find(7 * 123) == 623);
+    REQUIRE(index.find(1) == VehicleIndex::NPOS);
+
+    // Erase every other id; the rest must stay reachable across backward shifts.
+    for (int id = -500; id < 500; id += 2) REQUIRE(index.erase(id * 7));
+    REQUIRE_FALSE(index.erase(-500 * 7));
+    for (int id = -500; id < 500; ++id) {
+        std::size_t expected = id % 2 ? static_cast<std::size_t>(id + 500) : VehicleIndex::NPOS;
+        REQUIRE(index.find(id * 7) == expected);
+    }
+
+    index.assign(7 * 1, 42);
+    REQUIRE(index.find(7) == 42);
+    index.clear();
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.find(7) == VehicleIndex::NPOS);
+}
+
+TEST_CASE("FleetManager Indexed Updates", "[index]") {
+    std::vector<Vehicle> vehicles;
+    for (int i = 0; i < 1000; ++i)
+        vehicles.emplace_back(i, 60, 90, 50);
+    FleetManager fm(vehicles);
+
+    REQUIRE(fm.updateReading(4, 80, 130, 10));
+    REQUIRE(fm.evaluateAlerts().isOverheating(4));
+    REQUIRE(fm.averageSpeed() == Approx(60.02));
+
+    // Removing slot 0 moves the last vehicle (id 999) into it; lookups must follow.
+    REQUIRE(fm.removeVehicle(0));
+    REQUIRE_FALSE(fm.contains(0));
+    REQUIRE(fm.updateReading(999, 60, 90, 5));
+    REQUIRE(fm.fleetColumns().ids()[0] == 999);
+    REQUIRE(fm.fleetColumns().fuels()[0] == 5);
+
+    fm.addVehicle(Vehicle(5000, 60, 90, 50));
+    REQUIRE(fm.contains(5000));
+    REQUIRE(fm.size() == 1000);
+}
+
+TEST_CASE("Telemetry Stream Ingestion", "[stream]") {
+    FleetManager fm;
+    TelemetryStream stream(fm);
+
+    SECTION("Records split across chunks") {
+        const std::string input = "id,speed,temperature,fuel\n1,60,90,50\n2,70,1";
+        stream.consume(input.data(), input.size());
+        REQUIRE(stream.records() == 1);
+        REQUIRE(stream.pendingAlerts().empty());
+
+        const std::string rest = "15,20\n1,65,90,10\nbad\n3,50,100,40";
+        stream.consume(rest.data(), rest.size());
+        stream.finish();
+
+        REQUIRE(stream.records() == 4);
+        REQUIRE(stream.failures() == 1);
+        REQUIRE(fm.size() == 3);
+        REQUIRE(fm.fleetColumns().speeds()[0] == 65);
+        REQUIRE(fm.averageFuel() == Approx((10 + 20 + 40) / 3.0));
+        REQUIRE(stream.pendingAlerts() ==
+                "Vehicle ID 2: Critical Overheating\n"
+                "Vehicle ID 1: Low Fuel Warning\n");
+    }
+    SECTION("Reading from a file descriptor source") {
+        TempCsv csv("1,60,120,50\n2,70,90,50\n", "fleet_stream.csv");
+        TempCsv out("", "fleet_stream_alerts.txt");
+        {
+            std::FILE* sink = std::fopen(out.path.c_str(), "wb");
+            REQUIRE(stream.run(csv.path, fileno(sink)) == 2);
+            std::fclose(sink);
+        }
+        std::ifstream in(out.path);
+        std::string line;
+        std::getline(in, line);
+        REQUIRE(line == "Vehicle ID 1: Critical Overheating");
+        REQUIRE(stream.pendingAlerts().empty());
+    }
+}
+
+TEST_CASE("Binary Snapshot Round Trip", "[snapshot]") {
+    std::vector<Vehicle> vehicles;
+    for (int i = 0; i < 1000; ++i)
+        vehicles.emplace_back(i * 3 - 7, i * 0.5, 60 + i % 70, 100 - i % 100);
+    FleetColumns columns(vehicles);
+    TempCsv file("", "fleet_snapshot.fleet");
+    writeBinarySnapshot(columns, file.path);
+
+    SnapshotView view(file.path);
+    REQUIRE(view.size() == 1000);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(view.speeds()) % 64 == 0);
+    REQUIRE(view.ids()[0] == -7);
+    REQUIRE(view.temperatures()[999] == 60 + 999 % 70);
+
+    FleetManager fm(view.toColumns());
+    FleetManager reference(vehicles);
+    REQUIRE(fm.size() == 1000);
+    REQUIRE(fm.averageFuel() == Approx(reference.averageFuel()));
+    REQUIRE(fm.updateReading(-4, 0, 0, 0));
+
+    SECTION("Empty fleet") {
+        writeBinarySnapshot(FleetColumns(), file.path);
+        REQUIRE(SnapshotView(file.path).size() == 0);
+    }
+    SECTION("Rejects non-snapshot and truncated files") {
+        TempCsv csv("id,speed,temperature,fuel\n1,60,90,50\n1,60,90,50\n1,60,90,50\n", "fleet_not_snapshot.csv");
+        REQUIRE_THROWS_AS(SnapshotView(csv.path), std::runtime_error);
+
+        std::string bytes;
+        {
+            std::ifstream in(file.path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        TempCsv truncated(bytes.substr(0, bytes.size() - 8), "fleet_truncated.fleet");
+        REQUIRE_THROWS_AS(SnapshotView(truncated.path), std::runtime_error);
+    }
+}
+
+TEST_CASE("Synthetic Fleet Generator", "[synthetic]") {
+    SyntheticFleetProfile profile;
+    profile.temperature = ReadingDistribution::normal(95, 10, 40, 140);
+    profile.overheatingRate = 0.05;
+    profile.lowFuelRate = 0.25;
+
+    FleetColumns serial = generateSyntheticFleet(profile, 50000, 7, 1);
+    FleetColumns parallel = generateSyntheticFleet(profile, 50000, 7, 5);
+    REQUIRE(serial.size() == 50000);
+    REQUIRE(serial.ids()[49999] == 50000);
+    REQUIRE(std::equal(serial.temperatures(), serial.temperatures() + 50000, parallel.temperatures()));
+    REQUIRE(std::equal(serial.fuels(), serial.fuels() + 50000, parallel.fuels()));
+
+    FleetManager fm(std::move(parallel));
+    AlertMasks masks = fm.evaluateAlerts();
+    REQUIRE(masks.overheatingCount() / 50000.0 == Approx(0.05).margin(0.01));
+    REQUIRE(masks.lowFuelCount() / 50000.0 == Approx(0.25).margin(0.01));
+    REQUIRE(*std::min_element(serial.temperatures(), serial.temperatures() + 50000) >= 40);
+
+    SECTION("CSV output round trips through the loader") {
+        TempCsv csv("", "fleet_synthetic.csv");
+        writeFleetCsv(serial, csv.path);
+        std::vector<Vehicle> vehicles;
+        loadVehicleDataMapped(csv.path, vehicles);
+        FleetManager loaded(vehicles);
+        REQUIRE(loaded.size() == 50000);
+        REQUIRE(loaded.evaluateAlerts().overheatingCount() == masks.overheatingCount());
+        REQUIRE(loaded.evaluateAlerts().lowFuelCount() == masks.lowFuelCount());
+    }
+    SECTION("Inconsistent profiles are rejected") {
+        profile.fuel = ReadingDistribution::uniform(20, 90);
+        REQUIRE_THROWS_AS(generateSyntheticFleet(profile, 10), std::invalid_argument);
+        profile.fuel = ReadingDistribution::uniform(50, 10);
+        profile.lowFuelRate = -1;
+        REQUIRE_THROWS_AS(generateSyntheticFleet(profile, 10), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Pipeline Instrumentation", "[instrumentation]") {
+    using namespace instrumentation;
+    TempCsv csv("id,speed,temperature,fuel\n1,60,120,50\nbad\n2,70,90,10\n");
+    reset();
+
+    SECTION("Disabled hooks record nothing") {
+        std::vector<Vehicle> vehicles;
+        loadVehicleDataMapped(csv.path, vehicles);
+        FleetManager(vehicles).computeAverages();
+        REQUIRE(counter(Counter::RowsParsed) == 0);
+        REQUIRE(stage(Stage::ComputeAverages).calls == 0);
+    }
+    SECTION("Enabled hooks count rows, failures, bytes and alerts") {
+        enable();
+        std::vector<Vehicle> vehicles;
+        loadVehicleDataMapped(csv.path, vehicles);
+        FleetManager fm(vehicles);
+        fm.computeAverages();
+        TempCsv sink("", "fleet_instrumentation_alerts.txt");
+        std::FILE* out = std::fopen(sink.path.c_str(), "wb");
+        AlertReporter reporter;
+        reporter.format(fm.evaluateAlerts(), fm.fleetColumns().ids());
+        reporter.write(fileno(out));
+        std::fclose(out);
+        enable(false);
+
+        REQUIRE(counter(Counter::RowsParsed) == 2);
+        REQUIRE(counter(Counter::ParseFailures) == 1);
+        REQUIRE(counter(Counter::BytesRead) == 53);
+        REQUIRE(counter(Counter::AlertsEmitted) == 2);
+        REQUIRE(stage(Stage::ComputeAverages).calls == 1);
+        REQUIRE(stage(Stage::EvaluateAlerts).calls == 1);
+        REQUIRE(stage(Stage::WriteAlerts).maxNanoseconds <= stage(Stage::WriteAlerts).totalNanoseconds);
+
+        std::ostringstream json;
+        writeJson(json);
+        REQUIRE(json.str().find("\"rowsParsed\": 2") != std::string::npos);
+        REQUIRE(json.str().find("\"computeAverages\": {\"calls\": 1") != std::string::npos);
+    }
+    reset();
+}
+
+TEST_CASE("Configurable Alert Rules", "[rules]") {
+    std::istringstream config(
+        "# name metric op threshold message\n"
+        "overheating temperature > 110 Critical Overheating\n"
+        "\n"
+        "overspeed   speed       > 120\n"
+        "temp_rise   temperature rise 15 Rapid Temperature Rise\r\n"
+        "fuel_drop   fuel        drop 10 Sudden Fuel Drop\n");
+    std::vector<AlertRule> rules = parseAlertRules(config);
+    REQUIRE(rules.size() == 4);
+    REQUIRE(rules[1].message == "overspeed");
+    REQUIRE(rules[2].kind == RuleKind::RiseAbove);
+    REQUIRE(rules[2].message == "Rapid Temperature Rise");
+
+    std::vector<Vehicle> vehicles;
+    for (int i = 0; i < 130; ++i) vehicles.emplace_back(i + 1, 100, 90, 50);
+    vehicles[3] = Vehicle(4, 130, 115, 50);
+    vehicles[70] = Vehicle(71, 125, 90, 50);
+    FleetManager fm(vehicles);
+    AlertRuleEngine engine(rules);
+
+    RuleMasks masks = engine.evaluate(fm.fleetColumns());
+    REQUIRE(masks.count(0) == 1);
+    REQUIRE(masks.count(1) == 2);
+    REQUIRE(masks.test(70, 1));
+    REQUIRE(masks.count(2) + masks.count(3) == 0);  // No baseline yet
+
+    SECTION("Delta rules compare against the baseline of the same vehicle") {
+        engine.updateBaseline(fm.fleetColumns());
+        fm.updateReading(10, 100, 110, 50);   // +20 degrees
+        fm.updateReading(129, 100, 90, 35);   // -15 fuel, in the partial last block
+        fm.updateReading(20, 100, 100, 45);   // Below both deltas
+        masks = engine.evaluate(fm.fleetColumns());
+        REQUIRE(masks.count(2) == 1);
+        REQUIRE(masks.test(9, 2));
+        REQUIRE(masks.count(3) == 1);
+        REQUIRE(masks.test(128, 3));
+
+        // Vehicle 130 moves into slot 9; its readings are not compared with vehicle 10's baseline.
+        fm.removeVehicle(10);
+        fm.updateReading(130, 100, 120, 50);
+        masks = engine.evaluate(fm.fleetColumns());
+        REQUIRE_FALSE(masks.test(9, 2));
+    }
+    SECTION("Evaluating through the fleet advances the baseline like checkAlerts") {
+        masks = fm.evaluateAlerts(engine);
+        REQUIRE(masks.count(0) == 1);
+        REQUIRE(masks.count(2) == 0);
+        fm.updateReading(10, 100, 110, 50);
+        masks = fm.evaluateAlerts(engine);
+        REQUIRE(masks.count(2) == 1);
+        REQUIRE(masks.test(9, 2));
+        masks = fm.evaluateAlerts(engine);  // Same readings again: no change since the last check
+        REQUIRE(masks.count(2) == 0);
+    }
+    SECTION("Default rules reproduce the fixed alert report") {
+        AlertRuleEngine defaults;
+        AlertReporter fixed, configured;
+        fixed.format(fm.evaluateAlerts(), fm.fleetColumns().ids());
+        configured.format(defaults.evaluate(fm.fleetColumns()), defaults.rules(), fm.fleetColumns().ids());
+        REQUIRE(configured.text() == fixed.text());
+        REQUIRE(configured.lineCount() == 1);
+
+        AlertReporter all;
+        REQUIRE(all.format(masks, engine.rules(), fm.fleetColumns().ids()) ==
+                "Vehicle ID 4: Critical Overheating\n"
+                "Vehicle ID 4: overspeed\n"
+                "Vehicle ID 71: overspeed\n");
+    }
+    SECTION("Streams check each reading, comparing it with the vehicle's previous one") {
+        FleetManager streamed;
+        TelemetryStream stream(streamed);
+        stream.useRules(engine);
+        const std::string input = "7,100,90,50\n7,100,110,45\n7,130,112,30\n8,100,130,5\n";
+        stream.consume(input.data(), input.size());
+        REQUIRE(stream.pendingAlerts() ==
+                "Vehicle ID 7: Rapid Temperature Rise\n"
+                "Vehicle ID 7: Critical Overheating\n"
+                "Vehicle ID 7: overspeed\n"
+                "Vehicle ID 7: Sudden Fuel Drop\n"
+                "Vehicle ID 8: Critical Overheating\n");
+        REQUIRE(engine.evaluate(std::vector<double>{100, 90, 50}.data(), nullptr) == 0);
+    }
+    SECTION("Malformed rules are rejected") {
+        std::istringstream bad("overspeed velocity > 120\n");
+        REQUIRE_THROWS_AS(parseAlertRules(bad), std::runtime_error);
+        std::istringstream badOp("overspeed speed >= 120\n");
+        REQUIRE_THROWS_AS(parseAlertRules(badOp), std::runtime_error);
+    }
+}
+
+TEST_CASE("FleetManager Move-Aware Construction", "[construction]") {
+    std::vector<Vehicle> vehicles;
+    for (int i = 0; i < 100; ++i) vehicles.emplace_back(i, i, 60 + i, 100 - i);
+    FleetManager copied(vehicles);
+    std::vector<Vehicle> source = vehicles;
+    FleetManager moved(std::move(source));
+    REQUIRE(source.empty());
+    REQUIRE(moved.size() == 100);
+    REQUIRE(moved.averageTemperature() == Approx(copied.averageTemperature()));
+
+    FleetManager fm;
+    fm.addVehicle(Vehicle(1, 60, 120, 50));
+    fm.emplaceVehicle(2, 70.0, 90.0, 10.0);
+    fm.addVehicles(std::deque<Vehicle>{Vehicle(3, 80, 100, 40), Vehicle(4, 90, 95, 30)});
+    fm.addVehicles(std::vector<Vehicle>{});
+    REQUIRE(fm.size() == 4);
+    REQUIRE(fm.contains(2));
+    REQUIRE(fm.fleetColumns().ids()[3] == 4);
+    REQUIRE(fm.averageSpeed() == Approx(75));
+    REQUIRE(fm.updateReading(3, 0, 0, 0));
+    REQUIRE(fm.evaluateAlerts().lowFuelCount() == 2);
+}
+
+TEST_CASE("Telemetry History Ring Buffers", "[history]") {
+    TelemetryHistory history(10, 5);
+    REQUIRE(history.capacity() == 16);
+    history.resize(2);
+    REQUIRE(history.samples(0) == 0);
+    REQUIRE(std::isnan(history.mean(0, Metric::Speed, 4)));
+    REQUIRE(std::isnan(history.max(0, Metric::Speed)));
+    REQUIRE_THROWS_AS(TelemetryHistory(8, 9), std::invalid_argument);
+
+    SECTION("Incremental aggregates match a rescan across many wraps") {
+        std::vector<double> seen;
+        unsigned state = 12345;
+        for (int i = 0; i < 1000; ++i) {
+            state = state * 1103515245u + 12345u;
+            double value = (state >> 8) % 1000 / 10.0;
+            seen.push_back(value);
+            history.append(1, value, -value, 1e6 + value);
+
+            std::size_t retained = std::min<std::size_t>(seen.size(), 16);
+            REQUIRE(history.samples(1) == retained);
+            REQUIRE(history.sample(1, Metric::Speed, 0) == value);
+            for (std::size_t n : {std::size_t(1), std::size_t(3), retained, std::size_t(100)}) {
+                std::size_t m = std::min(n, retained);
+                double sum = 0;
+                for (std::size_t k = 0; k < m; ++k) sum += seen[seen.size() - 1 - k];
+                REQUIRE(history.mean(1, Metric::Speed, n) == Approx(sum / m));
+                REQUIRE(history.mean(1, Metric::Fuel, n) == Approx(1e6 + sum / m));
+            }
+            std::size_t w = std::min<std::size_t>(seen.size(), 5);
+            auto window = seen.end() - w;
+            REQUIRE(history.max(1, Metric::Speed) == *std::max_element(window, seen.end()));
+            REQUIRE(history.min(1, Metric::Speed) == *std::min_element(window, seen.end()));
+            REQUIRE(history.min(1, Metric::Temperature) == -history.max(1, Metric::Speed));
+        }
+        REQUIRE(history.samples(0) == 0);
+        REQUIRE_THROWS_AS(history.sample(1, Metric::Speed, 16), std::out_of_range);
+
+        history.swapRemove(0);
+        REQUIRE(history.slots() == 1);
+        REQUIRE(history.sample(0, Metric::Speed, 0) == seen.back());
+        history.clear(0);
+        REQUIRE(history.samples(0) == 0);
+    }
+    SECTION("FleetManager keeps histories with their vehicles") {
+        FleetManager fm;
+        fm.addVehicle(Vehicle(1, 50, 90, 80));
+        fm.addVehicle(Vehicle(2, 60, 95, 70));
+        REQUIRE(fm.history() == nullptr);
+        fm.enableHistory(8, 4);
+        fm.updateReading(2, 70, 100, 60);
+        fm.addVehicle(Vehicle(3, 10, 80, 40));
+        REQUIRE(fm.removeVehicle(1));
+
+        const TelemetryHistory& h = *fm.history();
+        REQUIRE(h.slots() == 2);
+        REQUIRE(h.samples(0) == 1);  // Vehicle 3 moved into slot 0
+        REQUIRE(h.sample(0, Metric::Speed, 0) == 10);
+        REQUIRE(h.samples(1) == 2);
+        REQUIRE(h.mean(1, Metric::Fuel, 8) == Approx(65));
+        REQUIRE(h.max(1, Metric::Temperature) == 100);
+    }
+}
+
+TEST_CASE("Sliding Window Fleet Statistics", "[windows]") {
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+    SlidingFleetStats windows(seconds(10), seconds(60));
+    REQUIRE(windows.span() == seconds(60));
+    REQUIRE(windows.query(seconds(0), seconds(60)).count() == 0);
+
+    // One reading per second for two minutes, speed equal to the second.
+    for (int t = 0; t < 120; ++t) windows.record(seconds(t), t, 90, 50);
+    const milliseconds now = seconds(119);
+
+    FleetStats last10 = windows.query(now, seconds(10));
+    REQUIRE(last10.count() == 10);
+    REQUIRE(last10.speed.mean == Approx(114.5));
+    REQUIRE(last10.speed.min == 110);
+    REQUIRE(last10.speed.max == 119);
+
+    FleetStats last30 = windows.query(now, seconds(25));  // Rounded up to three buckets
+    REQUIRE(last30.count() == 30);
+    REQUIRE(last30.speed.mean == Approx(104.5));
+
+    FleetStats all = windows.query(now, std::chrono::hours(1));  // Clamped to the span
+    REQUIRE(all.count() == 60);
+    REQUIRE(all.speed.min == 60);
+    REQUIRE(all.temperature.variance() == Approx(0).margin(1e-9));
+
+    // Late readings land in their bucket while it is still in the span.
+    windows.record(seconds(115), 1000, 90, 50);
+    windows.record(seconds(30), 1000, 90, 50);
+    REQUIRE(windows.dropped() == 1);
+    REQUIRE(windows.query(now, seconds(10)).speed.max == 1000);
+
+    // Idle time expires old buckets without any readings arriving.
+    REQUIRE(windows.query(seconds(165), seconds(60)).count() == 11);
+    REQUIRE(windows.query(seconds(300), seconds(60)).count() == 0);
+
+    SECTION("Streamed readings are recorded") {
+        FleetManager fm;
+        SlidingFleetStats live;
+        TelemetryStream stream(fm);
+        stream.trackWindows(live);
+        const std::string input = "1,50,90,40\n2,70,100,20\n1,60,95,30";
+        stream.consume(input.data(), input.size());
+        stream.finish();
+        FleetStats minute = live.query(SlidingFleetStats::now(), std::chrono::minutes(1));
+        REQUIRE(minute.count() == 3);
+        REQUIRE(minute.speed.mean == Approx(60));
+    }
+}
+
+TEST_CASE("Metric Histogram Quantiles", "[histogram]") {
+    MetricHistogram empty;
+    REQUIRE(std::isnan(empty.quantile(0.5)));
+
+    std::vector<double> values;
+    unsigned state = 777;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245u + 12345u;
+        values.push_back(((state >> 8) % 200000) / 100.0 - 500.0);  // [-500, 1500)
+    }
+    values.push_back(0.0);
+    values.push_back(1e9);  // Beyond the top bucket
+    MetricHistogram whole, left, right;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        whole.add(values[i]);
+        (i % 2 ? left : right).add(values[i]);
+    }
+    whole.add(std::nan(""));
+    left.merge(right);
+    REQUIRE(whole.count() == values.size());
+    REQUIRE(left.count() == whole.count());
+
+    std::sort(values.begin(), values.end());
+    for (double q : {0.001, 0.01, 0.25, 0.5, 0.9, 0.95, 0.99, 0.999}) {
+        double exact = values[static_cast<std::size_t>(std::ceil(q * values.size())) - 1];
+        REQUIRE(whole.quantile(q) == Approx(exact).epsilon(0.004).margin(0.004));
+        REQUIRE(left.quantile(q) == whole.quantile(q));
+    }
+    REQUIRE(whole.quantile(0) == values.front());
+    REQUIRE(whole.quantile(1) == 1e9);
+
+    SECTION("Fleet histograms are identical serial and parallel") {
+        FleetManager fm(generateSyntheticFleet(100000));
+        fm.setParallelism(1);
+        FleetHistograms serial = fm.histograms();
+        fm.setParallelism(4, 0);
+        FleetHistograms parallel = fm.histograms();
+        REQUIRE(serial.temperature.count() == 100000);
+        for (double q : {0.5, 0.95, 0.99}) {
+            REQUIRE(parallel.temperature.quantile(q) == serial.temperature.quantile(q));
+            REQUIRE(parallel.fuel.quantile(q) == serial.fuel.quantile(q));
+        }
+        REQUIRE(serial.temperature.quantile(0.5) == Approx(95).epsilon(0.02));
+    }
+}
+
+TEST_CASE("Concurrent Telemetry Ingestion", "[ingest]") {
+    SECTION("SPSC queue is bounded and FIFO") {
+        SpscQueue<int> queue(3);
+        REQUIRE(queue.capacity() == 4);
+        for (int i = 0; i < 4; ++i) REQUIRE(queue.tryPush(i));
+        REQUIRE_FALSE(queue.tryPush(4));
+        std::vector<int> out;
+        REQUIRE(queue.drain([&](int v) { out.push_back(v); }, 3) == 3);
+        REQUIRE(queue.tryPush(4));
+        REQUIRE(queue.drain([&](int v) { out.push_back(v); }, 10) == 2);
+        REQUIRE(out == std::vector<int>{0, 1, 2, 3, 4});
+        REQUIRE(queue.empty());
+    }
+    SECTION("Readings from every producer reach the fleet in per-producer order") {
+        FleetManager fm;
+        fm.addVehicle(Vehicle(1, 0, 0, 0));
+        const int producers = 4, perProducer = 20000;
+        {
+            ConcurrentIngest ingest(fm, producers, 16);  // Small queues force back-pressure
+            ingest.start();
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&ingest, p] {
+                    ConcurrentIngest::Producer producer = ingest.producer(p);
+                    for (int i = 0; i < perProducer; ++i) {
+                        // Each producer owns ids p*1000 + 1 .. p*1000 + 100; the last write wins.
+                        producer.push({p * 1000 + 1 + i % 100, double(i), 90.0 + p, 50.0});
+                    }
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+            ingest.stop();
+            REQUIRE(ingest.applied() == producers * perProducer);
+        }
+        REQUIRE(fm.size() == producers * 100);
+        for (int p = 0; p < producers; ++p) {
+            for (int k = 0; k < 100; ++k) {
+                std::size_t slot = std::find(fm.fleetColumns().ids(), fm.fleetColumns().ids() + fm.size(),
+                                             p * 1000 + 1 + k) - fm.fleetColumns().ids();
+                REQUIRE(slot < fm.size());
+                REQUIRE(fm.fleetColumns().speeds()[slot] == perProducer - 100 + k);
+                REQUIRE(fm.fleetColumns().temperatures()[slot] == 90.0 + p);
+            }
+        }
+        REQUIRE(fm.averageTemperature() == Approx(91.5));
+    }
+    SECTION("An idle applier sleeps and is woken by the next push") {
+        FleetManager fm;
+        ConcurrentIngest ingest(fm, 2);
+        ingest.start();
+        auto waitFor = [](auto condition) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!condition() && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return condition();
+        };
+        REQUIRE(waitFor([&] { return ingest.asleep(); }));
+
+        std::thread producer([&] { ingest.producer(1).push({7, 60, 120, 50}); });
+        producer.join();
+        REQUIRE(waitFor([&] { return ingest.applied() == 1; }));
+        REQUIRE(waitFor([&] { return ingest.asleep(); }));
+
+        ingest.stop();  // Wakes the sleeping applier
+        REQUIRE_FALSE(ingest.running());
+        REQUIRE(fm.contains(7));
+    }
+}
+
+TEST_CASE("Sharded FleetManager", "[sharded]") {
+    FleetColumns seed = generateSyntheticFleet(5000);
+    FleetManager reference{FleetColumns(seed)};
+    ShardedFleetManager sharded(seed, 4);
+    REQUIRE(sharded.shards() == 4);
+    REQUIRE(sharded.size() == 5000);
+    REQUIRE(sharded.averageTemperature() == Approx(reference.averageTemperature()));
+
+    std::vector<std::size_t> perShard(4);
+    for (int id = 1; id <= 5000; ++id) ++perShard[sharded.shardOf(id)];
+    for (std::size_t count : perShard) REQUIRE(count > 1000);
+
+    // Updates, new vehicles and removals, submitted from two threads with disjoint ids.
+    auto work = [](auto& fleet, int first) {
+        std::vector<TelemetryReading> batch;
+        for (int i = 0; i < 3000; ++i) {
+            int id = first + i % 4000;
+            double t = 60 + (i * 37) % 70;
+            if (i % 500 == 7) {
+                fleet.removeVehicle(id);
+            } else if (i % 3) {
+                fleet.upsertReading(id, i % 140, t, (i * 13) % 100);
+            } else {
+                batch.push_back({id, double(i % 140), t, double((i * 13) % 100)});
+                if (batch.size() == 64) {
+                    fleet.upsertReadings(batch.data(), batch.size());
+                    batch.clear();
+                }
+            }
+        }
+        fleet.upsertReadings(batch.data(), batch.size());
+    };
+    std::thread low([&] { work(sharded, 1); });
+    std::thread high([&] { work(sharded, 4001); });
+    low.join();
+    high.join();
+    sharded.flush();
+
+    // The same updates applied in sequence, grouped as each thread's would be.
+    struct Serial {
+        FleetManager& fleet;
+        void removeVehicle(int id) { fleet.removeVehicle(id); }
+        void upsertReading(int id, double s, double t, double f) { fleet.upsertReading(id, s, t, f); }
+        void upsertReadings(const TelemetryReading* r, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) fleet.upsertReading(r[i].id, r[i].speed, r[i].temperature, r[i].fuel);
+        }
+    } serial{reference};
+    work(serial, 1);
+    work(serial, 4001);
+
+    ShardSummary total = sharded.summary();
+    AlertMasks masks = reference.evaluateAlerts();
+    REQUIRE(total.vehicles == reference.size());
+    REQUIRE(sharded.averageSpeed() == Approx(reference.averageSpeed()));
+    REQUIRE(sharded.averageTemperature() == Approx(reference.averageTemperature()));
+    REQUIRE(sharded.averageFuel() == Approx(reference.averageFuel()));
+    REQUIRE(total.overheating == masks.overheatingCount());
+    REQUIRE(total.lowFuel == masks.lowFuelCount());
+}
+
+TEST_CASE("Fleet Read Views", "[views]") {
+    FleetViewStore views;
+    FleetManager fm;
+    for (int id = 1; id <= 1000; ++id) fm.addVehicle(Vehicle(id, 0, 90, 50));
+
+    SECTION("A pinned view survives later publishes and is reclaimed after release") {
+        FleetViewStore::Reader reader = views.registerReader();
+        REQUIRE(reader.read()->version() == 0);
+        views.publish(fm);
+        {
+            FleetViewStore::Guard pinned = reader.read();
+            REQUIRE(pinned->version() == 1);
+            for (int i = 0; i < 5; ++i) {
+                fm.updateReading(1, 1000, 90, 50);
+                views.publish(fm);
+            }
+            REQUIRE(views.retiredViews() == 5);
+            REQUIRE(pinned->size() == 1000);
+            REQUIRE(pinned->fleetColumns().speeds()[0] == 0);
+            REQUIRE(pinned->averageSpeed() == 0);
+        }
+        views.publish(fm);
+        REQUIRE(views.retiredViews() == 0);
+        FleetViewStore::Guard latest = reader.read();
+        REQUIRE(latest->version() == 7);
+        REQUIRE(latest->averageSpeed() == Approx(1.0));
+    }
+    SECTION("Readers always see a consistent view while a writer publishes") {
+        std::atomic<bool> done{false};
+        std::atomic<int> inconsistent{0};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                FleetViewStore::Reader reader = views.registerReader();
+                std::uint64_t lastVersion = 0;
+                while (!done.load()) {
+                    FleetViewStore::Guard view = reader.read();
+                    const double* speeds = view->fleetColumns().speeds();
+                    const double expected = view->version() ? speeds[0] : 0.0;
+                    bool ok = view->version() >= lastVersion &&
+                              (view->version() == 0 || view->averageSpeed() == Approx(expected));
+                    for (std::size_t i = 0; ok && i < view->size(); ++i) ok = speeds[i] == expected;
+                    if (!ok) ++inconsistent;
+                    lastVersion = view->version();
+                }
+            });
+        }
+        for (int version = 1; version <= 300; ++version) {
+            for (int id = 1; id <= 1000; ++id) fm.updateReading(id, version, 90, 50);
+            views.publish(fm);
+        }
+        done = true;
+        for (std::thread& reader : readers) reader.join();
+        REQUIRE(inconsistent == 0);
+        views.publish(fm);
+        REQUIRE(views.retiredViews() == 0);
+    }
+    SECTION("Concurrent ingestion publishes views of the fleet it owns") {
+        FleetViewStore::Reader reader = views.registerReader();
+        ConcurrentIngest ingest(fm, 1);
+        ingest.publishViews(views, 100);
+        ingest.start();
+        ConcurrentIngest::Producer producer = ingest.producer(0);
+        for (int id = 1001; id <= 1500; ++id) producer.push({id, 10.0, 90.0, 50.0});
+        ingest.stop();
+        REQUIRE(reader.read()->size() == 1500);
+        REQUIRE(reader.read()->averageSpeed() == Approx(10.0 / 3));
+    }
+    SECTION("A trickle of readings is published at most once per gap, and still published when idle") {
+        FleetViewStore::Reader reader = views.registerReader();
+        ConcurrentIngest ingest(fm, 1);
+        ingest.publishViews(views, ConcurrentIngest::DEFAULT_PUBLISH_INTERVAL, std::chrono::milliseconds(50));
+        ingest.start();
+        ConcurrentIngest::Producer producer = ingest.producer(0);
+        const auto begin = std::chrono::steady_clock::now();
+        for (int id = 1001; id <= 1100; ++id) {
+            producer.push({id, 10.0, 90.0, 50.0});
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        // The last readings reach a view without another push or stop().
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (reader.read()->size() < 1100 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        REQUIRE(reader.read()->size() == 1100);
+        const std::uint64_t published = reader.read()->version();
+        REQUIRE(published <= static_cast<std::uint64_t>(elapsed / std::chrono::milliseconds(50)) + 2);
+        REQUIRE(published < 100);
+        ingest.stop();
+        REQUIRE(reader.read()->version() == published);
+    }
+}
+
+TEST_CASE("Work-Stealing Task Pool", "[pool]") {
+    TaskPool pool(4);
+    REQUIRE(pool.workers() == 4);
+
+    SECTION("parallelFor covers every index exactly once, including nested loops") {
+        std::vector<std::atomic<int>> hits(100000);
+        TaskGroup jobs;
+        for (int job = 0; job < 4; ++job) {
+            pool.submit(jobs, [&, job] {
+                pool.parallelFor(25000, 1000, [&](std::size_t first, std::size_t last) {
+                    for (std::size_t i = first; i < last; ++i) ++hits[job * 25000 + i];
+                });
+            });
+        }
+        pool.wait(jobs);
+        REQUIRE(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& h) { return h == 1; }));
+    }
+    SECTION("Task exceptions reach the waiting thread") {
+        TaskGroup group;
+        pool.submit(group, [] { throw std::runtime_error("job failed"); });
+        pool.submit(group, [] {});
+        REQUIRE_THROWS_AS(pool.wait(group), std::runtime_error);
+        REQUIRE(group.done());
+    }
+    SECTION("Fleet scans on the pool match the serial results") {
+        FleetManager fm(generateSyntheticFleet(100001));
+        FleetStats serialStats = fm.statistics();
+        AlertMasks serialMasks = fm.evaluateAlerts();
+        FleetHistograms serialHistograms = fm.histograms();
+        fm.setParallelism(1);
+        fm.computeAverages();
+        double serialAverage = fm.averageTemperature();
+
+        fm.setTaskPool(&pool);
+        fm.setParallelism(0, 0);
+        fm.computeAverages();
+        REQUIRE(fm.averageTemperature() == Approx(serialAverage).epsilon(1e-12));
+        FleetStats stats = fm.statistics();
+        REQUIRE(stats.count() == serialStats.count());
+        REQUIRE(stats.fuel.mean == Approx(serialStats.fuel.mean).epsilon(1e-12));
+        REQUIRE(stats.speed.max == serialStats.speed.max);
+        AlertMasks masks = fm.evaluateAlerts();
+        REQUIRE(masks.overheating == serialMasks.overheating);
+        REQUIRE(masks.lowFuel == serialMasks.lowFuel);
+        REQUIRE(fm.histograms().temperature.quantile(0.99) == serialHistograms.temperature.quantile(0.99));
+    }
+}
+
+TEST_CASE("Edge-Triggered Alert State", "[alert-state]") {
+    AlertState state;
+
+    SECTION("Alerts are reported once per transition, with hysteresis") {
+        REQUIRE(state.update(0, 7, 112, 50) == AlertEdge::OVERHEATING_RAISED);
+        REQUIRE(state.update(0, 7, 115, 50) == 0);
+        REQUIRE(state.update(0, 7, 108, 50) == 0);  // Inside the band: still overheating
+        REQUIRE(state.update(0, 7, 111, 50) == 0);
+        REQUIRE(state.update(0, 7, 104, 50) == AlertEdge::OVERHEATING_CLEARED);
+        REQUIRE(state.update(0, 7, 108, 50) == 0);  // Inside the band: still clear
+
+        REQUIRE(state.update(0, 7, 90, 14) == AlertEdge::LOW_FUEL_RAISED);
+        REQUIRE(state.update(0, 7, 90, 16) == 0);
+        REQUIRE(state.update(0, 7, 120, 18) == (AlertEdge::OVERHEATING_RAISED | AlertEdge::LOW_FUEL_CLEARED));
+        REQUIRE(state.activeAlerts().isOverheating(0));
+        REQUIRE_FALSE(state.activeAlerts().hasLowFuel(0));
+    }
+    SECTION("A slot taken over by another vehicle starts without alerts") {
+        REQUIRE(state.update(3, 1, 120, 10) == (AlertEdge::OVERHEATING_RAISED | AlertEdge::LOW_FUEL_RAISED));
+        REQUIRE(state.update(3, 2, 120, 50) == AlertEdge::OVERHEATING_RAISED);
+        REQUIRE_FALSE(state.activeAlerts().hasLowFuel(3));
+    }
+    SECTION("Whole-fleet updates report only changes and match per-reading updates") {
+        FleetManager fm(generateSyntheticFleet(5000));
+        AlertTransitions first = fm.alertChanges();
+        AlertMasks alerts = fm.evaluateAlerts();
+        REQUIRE(first.raised.overheating == alerts.overheating);
+        REQUIRE(first.raised.lowFuel == alerts.lowFuel);
+        REQUIRE(first.cleared.overheatingCount() + first.cleared.lowFuelCount() == 0);
+        REQUIRE(fm.alertChanges().count() == 0);
+
+        const FleetColumns& columns = fm.fleetColumns();
+        for (std::size_t i = 0; i < columns.size(); ++i)
+            state.update(i, columns.ids()[i], columns.temperatures()[i], columns.fuels()[i]);
+
+        std::size_t hot = 1;
+        while (alerts.isOverheating(hot)) ++hot;
+        fm.updateReading(columns.ids()[hot], 60, 130, 50);
+        fm.updateReading(columns.ids()[hot + 1], 60, 60, 90);
+        fm.removeVehicle(columns.ids()[0]);  // Last vehicle moves into slot 0
+        state.swapRemove(0, columns.size());
+
+        AlertTransitions next = fm.alertChanges();
+        REQUIRE(next.raised.isOverheating(hot));
+        REQUIRE_FALSE(next.raised.isOverheating(hot + 1));
+        REQUIRE_FALSE(next.raised.isOverheating(0));
+        REQUIRE_FALSE(next.raised.hasLowFuel(0));
+        REQUIRE(next.count() <= 3);
+        AlertReporter reporter;
+        reporter.format(next, columns.ids());
+        REQUIRE(reporter.lineCount() == next.count());
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            unsigned edges = state.update(i, columns.ids()[i], columns.temperatures()[i], columns.fuels()[i]);
+            REQUIRE(bool(edges & AlertEdge::OVERHEATING_RAISED) == next.raised.isOverheating(i));
+            REQUIRE(bool(edges & AlertEdge::OVERHEATING_CLEARED) == next.cleared.isOverheating(i));
+            REQUIRE(bool(edges & AlertEdge::LOW_FUEL_RAISED) == next.raised.hasLowFuel(i));
+            REQUIRE(bool(edges & AlertEdge::LOW_FUEL_CLEARED) == next.cleared.hasLowFuel(i));
+        }
+        REQUIRE(state.activeAlerts().overheating == fm.alertState().activeAlerts().overheating);
+        REQUIRE(state.activeAlerts().lowFuel == fm.alertState().activeAlerts().lowFuel);
+    }
+    SECTION("Removing a vehicle leaves the alerts of the vehicle moved into its slot alone") {
+        FleetManager fm(std::vector<Vehicle>{Vehicle(1, 60, 90, 50), Vehicle(2, 60, 120, 50),
+                                             Vehicle(3, 60, 112, 10)});
+        REQUIRE(fm.alertChanges().count() == 3);
+        fm.updateReading(3, 60, 108, 12);  // Inside both hysteresis bands: still active
+        REQUIRE(fm.alertChanges().count() == 0);
+
+        REQUIRE(fm.removeVehicle(1));  // Vehicle 3 moves into slot 0
+        REQUIRE(fm.alertChanges().count() == 0);
+        REQUIRE(fm.alertState().activeAlerts().isOverheating(0));
+        REQUIRE(fm.alertState().activeAlerts().hasLowFuel(0));
+        REQUIRE(fm.alertState().activeAlerts().size == 2);
+
+        REQUIRE(fm.updateReading(3, 60, 100, 50));
+        REQUIRE(fm.alertChanges(3) == (AlertEdge::OVERHEATING_CLEARED | AlertEdge::LOW_FUEL_CLEARED));
+        REQUIRE(fm.removeVehicle(2));
+        REQUIRE(fm.alertChanges().count() == 0);
+        fm.addVehicle(Vehicle(4, 60, 120, 50));  // Reuses slot 1 with no inherited state
+        REQUIRE(fm.alertChanges(4) == AlertEdge::OVERHEATING_RAISED);
+    }
+    SECTION("Streams write repeated alerts once") {
+        FleetManager fm;
+        TelemetryStream stream(fm);
+        const std::string input = "1,60,120,50\n1,60,115,50\n1,60,108,12\n1,60,100,20\n1,60,100,20\n";
+        stream.consume(input.data(), input.size());
+        REQUIRE(stream.pendingAlerts() ==
+                "Vehicle ID 1: Critical Overheating\n"
+                "Vehicle ID 1: Low Fuel Warning\n"
+                "Vehicle ID 1: Overheating Cleared\n"
+                "Vehicle ID 1: Low Fuel Cleared\n");
+    }
+}